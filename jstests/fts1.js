@@ -0,0 +1,66 @@
+// text indexes and the text command
+
+t = db.fts1;
+t.drop();
+
+function search( s, filter, limit ) {
+    var cmd = { text : t.getName(), search : s };
+    if ( filter ) cmd.filter = filter;
+    if ( limit ) cmd.limit = limit;
+    var res = db.runCommand( cmd );
+    assert( res.ok, tojson( res ) );
+    return res;
+}
+
+function ids( res ) {
+    return res.results.map( function( r ) { return r.obj._id; } );
+}
+
+t.save( { _id : 1, title : "indexing", body : "the btree indexes keys in order" } );
+t.save( { _id : 2, title : "storage", body : "records are stored in extents, not indexed" } );
+t.save( { _id : 3, title : "replication", body : "secondaries apply the oplog", lang : "en" } );
+t.save( { _id : 4, title : "sharding", body : [ "chunks move", "between shards" ], lang : "en" } );
+
+assert.eq( 0, db.runCommand( { text : t.getName(), search : "btree" } ).ok, "no index yet" );
+
+t.ensureIndex( { title : "text", body : "text" }, { weights : { title : 10 } } );
+assert.isnull( db.getLastError() );
+
+var spec = db.system.indexes.findOne( { ns : t.getFullName(), name : "title_text_body_text" } );
+assert.eq( { _fts : "text", _ftsx : 1 }, spec.key );
+assert.eq( { body : 1, title : 10 }, spec.weights );
+
+// stemming on both sides, and stop words ignored
+assert.eq( [ 1 ], ids( search( "btree" ) ) );
+assert.eq( [ 1, 2 ], ids( search( "index" ) ), "title is weighed higher" );
+assert.eq( [ 1, 2 ], ids( search( "the Indexes" ) ) );
+assert.eq( [], ids( search( "the" ) ) );
+assert.eq( [ 4 ], ids( search( "chunk" ) ), "array of strings" );
+
+// any term matches, and documents matching more terms score higher
+var res = search( "oplog btree extents" );
+assert.eq( 3, res.results.length );
+assert.eq( 3, res.stats.nfound );
+res = search( "oplog secondaries btree" );
+assert.eq( [ 3, 1 ], ids( res ) );
+assert.gt( res.results[0].score, res.results[1].score );
+
+// filter and limit
+assert.eq( [ 3 ], ids( search( "oplog btree", { lang : "en" } ) ) );
+assert.eq( 1, search( "index", null, 1 ).results.length );
+
+// the index follows updates and removes
+t.update( { _id : 3 }, { $set : { body : "secondaries replay btree changes" } } );
+assert.eq( [ 1, 3 ], ids( search( "btree" ) ).sort() );
+t.remove( { _id : 1 } );
+assert.eq( [ 3 ], ids( search( "btree" ) ) );
+
+// ordinary queries don't use the text index
+assert.eq( "BasicCursor", t.find( { title : "storage" } ).explain().cursor );
+assert.eq( 1, t.find( { title : "storage" } ).itcount() );
+
+// only one text index per collection is searchable, and only text fields may be indexed
+t.ensureIndex( { title : "text", lang : 1 } );
+assert( db.getLastError() );
+t.ensureIndex( { title : "text" }, { unique : true } );
+assert( db.getLastError() );
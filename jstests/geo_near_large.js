@@ -0,0 +1,62 @@
+// $near with more results wanted than a single search pass returns
+
+t = db.geo_near_large;
+t.drop();
+
+// 60 x 60 grid, with ties at every distance from the center
+for ( var x = 0; x < 60; x++ ) {
+    for ( var y = 0; y < 60; y++ ) {
+        t.insert( { _id : x * 60 + y, loc : [ x, y ] } );
+    }
+}
+// a doc with several locations is returned once per location unless $uniqueDocs is set
+t.insert( { _id : "multi", loc : [ [ 30, 30 ], [ 30.5, 30 ], [ 10, 10 ] ] } );
+t.ensureIndex( { loc : "2d" } );
+assert.isnull( db.getLastError() );
+
+function dist( a, b ) {
+    return Math.sqrt( ( a[0] - b[0] ) * ( a[0] - b[0] ) + ( a[1] - b[1] ) * ( a[1] - b[1] ) );
+}
+
+// nearest location of the doc to 'near'
+function minDist( doc, near ) {
+    if ( typeof( doc.loc[0] ) == "number" ) return dist( doc.loc, near );
+    var d = null;
+    doc.loc.forEach( function( l ) { var x = dist( l, near ); if ( d == null || x < d ) d = x; } );
+    return d;
+}
+
+function check( query, num, expected, unique ) {
+    var near = query.loc.$near;
+    var res = t.find( query ).limit( num ).batchSize( 200 ).toArray();
+    assert.eq( expected, res.length, tojson( query ) );
+
+    var last = -1;
+    var multi = 0;
+    for ( var i = 0; i < res.length; i++ ) {
+        if ( res[i]._id == "multi" ) {
+            multi++;
+            continue;
+        }
+        var d = minDist( res[i], near );
+        assert.gte( d, last, "out of order at " + i + " " + tojson( query ) );
+        last = d;
+    }
+    assert.eq( unique ? 1 : 3, multi, tojson( query ) );
+}
+
+check( { loc : { $near : [ 30, 30 ] } }, 5000, 3603, false );
+check( { loc : { $near : [ 30, 30 ], $uniqueDocs : true } }, 5000, 3601, true );
+check( { loc : { $near : [ 0, 0 ] } }, 3000, 3000, false );
+
+// documents are not repeated across passes
+var seen = {};
+t.find( { loc : { $near : [ 30, 30 ], $uniqueDocs : true } } ).limit( 3601 ).forEach( function( doc ) {
+    assert( !seen[ doc._id ], "repeated " + doc._id );
+    seen[ doc._id ] = true;
+} );
+
+// $maxDistance and other predicates still apply on every pass
+var res = t.find( { loc : { $near : [ 30, 30 ], $maxDistance : 20 }, _id : { $mod : [ 2, 0 ] } } ).limit( 5000 ).toArray();
+var expected = t.find( { loc : { $within : { $center : [ [ 30, 30 ], 20 ] } }, _id : { $mod : [ 2, 0 ] } } ).count();
+assert.eq( expected, res.length );
@@ -0,0 +1,25 @@
+// getMore replies are sent in several buffers; check documents arrive whole and in order across
+// buffer boundaries, including documents larger than a buffer.
+
+t = db.jstests_getmore_segments;
+t.drop();
+
+var small = new Array( 3000 ).toString();
+var large = new Array( 600 * 1024 ).toString();
+for( i = 0; i < 3000; ++i ) {
+    t.insert( { _id:i, s:( i % 500 == 7 ? large : small ) } );
+}
+assert.isnull( db.getLastError() );
+
+var c = t.find().sort( { _id:1 } ).batchSize( 2 );
+var n = 0;
+while( c.hasNext() ) {
+    var o = c.next();
+    assert.eq( n, o._id );
+    assert.eq( n % 500 == 7 ? large.length : small.length, o.s.length );
+    ++n;
+}
+assert.eq( 3000, n );
+
+// a large batch, ended by the reply size limit rather than a count
+assert.eq( 3000, t.find().itcount() );
@@ -1,8 +1,8 @@
 var t = db.hashindex1;
 t.drop()
 
-//test non-single field hashed indexes don't get created (maybe change later)
-var badspec = {a : "hashed" , b : 1};
+//test indexes with several hashed fields don't get created (maybe change later)
+var badspec = {a : "hashed" , b : "hashed"};
 t.ensureIndex( badspec );
 assert.eq( t.getIndexes().length , 1 , "only _id index should be created");
 
@@ -50,6 +50,13 @@ assert.eq( t.find({a : {$in : [1,2]}}).explain()["cursor"] ,
            "BtreeCursor a_hashed multi" ,
            "not using hashed cursor");
 
+//test hashed point lookups are chosen over other usable btree indexes
+t.ensureIndex( {c : 1} );
+assert.eq( t.find({a : 1 , c : {$gt : 0}}).explain().cursor ,
+		cursorname ,
+		"hashed point lookup lost to btree plan");
+t.dropIndex( {c : 1} );
+
 
 //test creation of index based on hash of _id index
 var goodspec2 = {'_id' : "hashed"};
@@ -0,0 +1,49 @@
+// compound hashed indexes: an ordered prefix followed by a hashed field
+var t = db.hashindex2;
+t.drop();
+
+var spec = {tenant : 1 , user : "hashed"};
+t.ensureIndex( spec );
+assert.eq( t.getIndexes().length , 2 , "compound hashed index didn't get created");
+
+for( var tenant = 0; tenant < 5; tenant++ ){
+    for( var user = 0; user < 20; user++ ){
+        t.insert( {tenant : tenant , user : user} );
+    }
+}
+assert.eq( t.find().hint( spec ).itcount() , 100 , "index is missing documents");
+
+// point lookups use the hash of the hashed field
+var cursorname = "BtreeCursor tenant_1_user_hashed";
+var exp = t.find( {tenant : 3 , user : 7} ).explain();
+assert.eq( exp.cursor , cursorname , "not using compound hashed cursor");
+assert.eq( exp.n , 1 );
+assert.lte( exp.nscanned , 2 , "point lookup scanned too much");
+
+exp = t.find( {tenant : 3 , user : {$in : [1 , 2 , 3]}} ).explain();
+assert.eq( exp.n , 3 );
+assert.lte( exp.nscanned , 6 , "$in lookup scanned too much");
+
+// the ordered prefix is scanned as a range
+var res = t.find( {tenant : 2} ).hint( spec );
+assert.eq( res.itcount() , 20 , "prefix query found wrong documents");
+exp = t.find( {tenant : 2} ).hint( spec ).explain();
+assert.lte( exp.nscanned , 21 , "prefix query scanned too much");
+
+res = t.find( {tenant : {$gte : 1 , $lte : 2} , user : 5} ).hint( spec );
+assert.eq( res.itcount() , 2 , "prefix range and point found wrong documents");
+
+// ranges on the hashed field still return the right documents
+res = t.find( {tenant : 4 , user : {$gt : 15}} ).hint( spec );
+assert.eq( res.itcount() , 4 , "hashed field range found wrong documents");
+
+// hashed values never stand in for the document's own fields
+res = t.find( {tenant : 1 , user : 9} , {_id : 0 , tenant : 1 , user : 1} ).hint( spec ).toArray();
+assert.eq( res.length , 1 );
+assert.eq( res[0].user , 9 , "covered projection returned a hash");
+
+// only one field may be hashed
+var u = db.hashindex2b;
+u.drop();
+u.ensureIndex( {a : "hashed" , b : "hashed"} );
+assert.eq( u.getIndexes().length , 1 , "index with two hashed fields got created");
@@ -0,0 +1,65 @@
+// partial indexes only hold documents matching partialFilterExpression
+
+t = db.index_partial1;
+t.drop();
+
+for ( var i = 0; i < 100; i++ ) {
+    t.insert( { _id : i, a : i % 10, active : ( i % 50 == 0 ), score : i } );
+}
+
+t.ensureIndex( { a : 1 }, { partialFilterExpression : { active : true } } );
+assert.isnull( db.getLastError() );
+t.ensureIndex( { score : 1 }, { partialFilterExpression : { score : { $gte : 90 } } } );
+assert.isnull( db.getLastError() );
+
+function cursor( q ) {
+    return t.find( q ).explain().cursor;
+}
+
+// only the matching documents are indexed
+assert.eq( 2, t.find().hint( { a : 1 } ).itcount() );
+assert.eq( 10, t.find().hint( { score : 1 } ).itcount() );
+assert( t.validate().valid );
+
+// used when the query implies the filter
+assert.eq( "BtreeCursor a_1", cursor( { a : 0, active : true } ) );
+assert.eq( 2, t.find( { a : 0, active : true } ).itcount() );
+assert.eq( "BtreeCursor score_1", cursor( { score : { $gt : 95 } } ) );
+assert.eq( 4, t.find( { score : { $gt : 95 } } ).itcount() );
+assert.eq( "BtreeCursor score_1", cursor( { score : { $in : [ 91, 99 ] } } ) );
+assert.eq( 2, t.find( { score : { $in : [ 91, 99 ] } } ).itcount() );
+
+// and not otherwise
+assert.eq( "BasicCursor", cursor( { a : 0 } ) );
+assert.eq( 10, t.find( { a : 0 } ).itcount() );
+assert.eq( "BasicCursor", cursor( { a : 0, active : false } ) );
+assert.eq( "BasicCursor", cursor( { score : { $gt : 50 } } ) );
+assert.eq( 49, t.find( { score : { $gt : 50 } } ).itcount() );
+
+// documents move in and out of the index as they're updated
+t.update( { _id : 10 }, { $set : { active : true } } );
+assert.eq( 3, t.find( { a : 0, active : true } ).itcount() );
+t.update( { _id : 0 }, { $set : { active : false } } );
+assert.eq( [ 10, 50 ], t.find( { a : 0, active : true } ).toArray().map( function( o ) { return o._id; } ).sort() );
+assert.eq( 2, t.find().hint( { a : 1 } ).itcount() );
+t.remove( { _id : 99 } );
+assert.eq( 9, t.find().hint( { score : 1 } ).itcount() );
+assert( t.validate().valid );
+
+// unique only among the indexed documents
+t.ensureIndex( { score : -1 }, { unique : true, partialFilterExpression : { active : true } } );
+assert.isnull( db.getLastError() );
+t.insert( { _id : 200, score : 1000 } );
+assert.isnull( db.getLastError() );
+t.insert( { _id : 201, score : 1000, active : true } );
+assert.isnull( db.getLastError() );
+t.insert( { _id : 202, score : 1000, active : true } );
+assert( db.getLastError() );
+
+// filters the optimizer can't reason about are rejected
+t.ensureIndex( { b : 1 }, { partialFilterExpression : { $where : "true" } } );
+assert( db.getLastError() );
+t.ensureIndex( { c : 1 }, { partialFilterExpression : { $or : [ { c : 1 }, { c : 2 } ] } } );
+assert( db.getLastError() );
+t.ensureIndex( { d : 1 }, { partialFilterExpression : 5 } );
+assert( db.getLastError() );
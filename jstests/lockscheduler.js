@@ -0,0 +1,53 @@
+// Check the lock scheduler's setParameter options and serverStatus section.
+
+// mongod only
+if ( db.isMaster().msg != "isdbgrid" ) {
+
+    var admin = db.getSisterDB( "admin" );
+    var t = db.jstests_lockscheduler;
+    t.drop();
+
+    function status() {
+        return db.serverStatus().lockScheduler;
+    }
+
+    assert( !status().on );
+    assert.eq( 1, status().background.weight );
+
+    // bad settings are refused and change nothing
+    assert.commandFailed( admin.runCommand( { setParameter:1, lockScheduler:5 } ) );
+    assert.commandFailed( admin.runCommand( { setParameter:1, lockScheduler:{ tickets:-1 } } ) );
+    assert.commandFailed( admin.runCommand( { setParameter:1,
+                                              lockScheduler:{ weights:{ nosuchclass:1 } } } ) );
+    assert.commandFailed( admin.runCommand( { setParameter:1,
+                                              lockScheduler:{ weights:{ userRead:0 } } } ) );
+    assert( !status().on );
+
+    try {
+        assert.commandWorked( admin.runCommand( { setParameter:1,
+                                                  lockScheduler:{ tickets:4,
+                                                                  maxQueueMillis:200,
+                                                                  weights:{ userRead:2 } } } ) );
+        var before = status();
+        assert( before.on );
+        assert.eq( 4, before.out );
+        assert.eq( 200, before.maxQueueMillis );
+        assert.eq( 2, before.userRead.weight );
+        assert.eq( 4, before.userWrite.weight );
+
+        for( var i = 0; i < 10; i++ ) {
+            t.insert( { i:i } );
+        }
+        assert.eq( 10, t.find().itcount() );
+
+        var after = status();
+        assert.lte( before.userWrite.granted + 10, after.userWrite.granted );
+        assert.lt( before.userRead.granted, after.userRead.granted );
+    }
+    finally {
+        assert.commandWorked( admin.runCommand( { setParameter:1, lockScheduler:{ tickets:0 } } ) );
+    }
+    assert( !status().on );
+
+    t.drop();
+}
@@ -0,0 +1,48 @@
+// latency histograms in serverStatus.opLatencies and per namespace in top
+
+// mongod only
+if ( db.isMaster().msg != "isdbgrid" ) {
+
+    t = db.oplatencies;
+    t.drop();
+
+    function latencies() {
+        var res = db.serverStatus();
+        assert( res.opLatencies, tojson( res ) );
+        return res.opLatencies;
+    }
+
+    var before = latencies();
+    [ "insert", "query", "update", "delete", "getmore", "command" ].forEach( function( op ) {
+        assert( before[op], op );
+        assert.eq( "number", typeof( before[op].p99 ), op );
+    } );
+
+    for ( var i = 0; i < 20; i++ ) {
+        t.insert( { _id : i } );
+        t.findOne( { _id : i } );
+    }
+    db.getLastError();
+
+    var after = latencies();
+    assert.lte( before.insert.count + 20, after.insert.count );
+    assert.lte( before.query.count + 20, after.query.count );
+
+    var q = after.query;
+    assert.lte( q.p50, q.p99 );
+    assert.lte( q.p99, q.p999 );
+    var n = 0;
+    q.buckets.forEach( function( b ) {
+        assert.eq( 2, b.length );
+        assert.lt( 0, b[1] );
+        n += b[1];
+    } );
+    assert.eq( q.count, n );
+
+    // per namespace
+    var top = db.adminCommand( "top" ).totals[ t.getFullName() ];
+    assert( top, "no top entry" );
+    assert.lte( 40, top.latency.count );
+    assert.lte( top.latency.p50, top.latency.p999 );
+
+}
@@ -0,0 +1,40 @@
+// $or clauses are deduplicated on the index key when it holds the fields of the prior clauses,
+// so counts and covered results stay correct without loading the records.
+
+t = db.jstests_ors;
+t.drop();
+
+t.ensureIndex( { a:1 } );
+t.ensureIndex( { b:1, a:1 } );
+for( i = 0; i < 100; ++i ) {
+    t.save( { a:i % 10, b:i % 7 } );
+}
+// missing and null fields are keyed as null
+t.save( { b:1 } );
+t.save( { a:null, b:1 } );
+
+function check( query ) {
+    var expected = t.find( query ).hint( { $natural:1 } ).itcount();
+    assert.eq( expected, t.count( query ), tojson( query ) );
+    assert.eq( expected, t.find( query ).itcount(), tojson( query ) );
+    assert.eq( expected, t.find( query, { _id:0, a:1, b:1 } ).itcount(), tojson( query ) );
+}
+
+check( { $or:[ { a:1 }, { b:1 } ] } );
+check( { $or:[ { a:{ $gte:5 } }, { b:{ $in:[ 1, 2 ] } } ] } );
+check( { $or:[ { a:null }, { b:1 } ] } );
+check( { $or:[ { a:{ $in:[ 1, 2 ] } }, { b:1 }, { b:3, a:{ $lt:5 } } ] } );
+
+// the second clause is answered from its index
+var explain = t.find( { $or:[ { a:1 }, { b:1 } ] }, { _id:0, a:1, b:1 } ).explain();
+assert.eq( "BtreeCursor b_1_a_1", explain.clauses[ 1 ].cursor );
+assert( explain.clauses[ 1 ].indexOnly );
+
+// aggregation over covered fields gives the same groups
+var res = t.aggregate( { $match:{ $or:[ { a:1 }, { b:1 } ] } },
+                       { $project:{ _id:0, a:1, b:1 } },
+                       { $group:{ _id:"$b", n:{ $sum:1 } } } );
+assert.commandWorked( res );
+var total = 0;
+res.result.forEach( function( g ) { total += g.n; } );
+assert.eq( t.count( { $or:[ { a:1 }, { b:1 } ] } ), total );
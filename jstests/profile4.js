@@ -57,6 +57,8 @@ try {
     assert.lt( 0, o.lockStats.timeLockedMicros.w );
     assert.eq( 0, o.lockStats.timeAcquiringMicros.r );
     assert.lt( 0, o.lockStats.timeAcquiringMicros.w );
+    // the collection is created by this insert, so writing it takes some time
+    assert.lt( 0, o.waitMicros.write );
 
     // check read lock stats are set
     t.find();
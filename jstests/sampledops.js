@@ -0,0 +1,34 @@
+// sampledOps estimates where operations in progress spend their time
+
+if ( db.isMaster().msg != "isdbgrid" ) {
+
+    t = db.sampledops;
+    t.drop();
+
+    for ( var i = 0; i < 10; i++ ) {
+        t.insert( { _id : i } );
+    }
+    db.getLastError();
+
+    // a query that stays in progress for a while
+    assert.eq( 10, t.find( { $where : "sleep( 30 ); return true;" } ).itcount() );
+
+    var res = db.adminCommand( { sampledOps : 1 } );
+    assert( res.ok, tojson( res ) );
+    assert.lt( 0, res.intervalMillis );
+    assert.lt( 0, res.current.samples );
+
+    var ns = res.current.namespaces[ t.getFullName() ];
+    assert( ns, tojson( res ) );
+    assert.lt( 0, ns.total );
+    var stages = 0;
+    [ "other", "lockWait", "pageFault", "scan", "match", "write", "journalWait" ].forEach( function( s ) {
+        if ( ns[s] )
+            stages += ns[s];
+    } );
+    assert.eq( ns.total, stages );
+    assert.lt( 0, ns.match, "the $where runs while matching" );
+
+    // admin only
+    assert.eq( 0, db.runCommand( { sampledOps : 1 } ).ok );
+}
@@ -0,0 +1,31 @@
+// Tests the per host checkout counters reported by connPoolStats
+
+var s = new ShardingTest( "conn_pool_stats" , 1 , 0 , 1 );
+
+var db = s.getDB( "test" );
+
+for ( var i = 0; i < 50; i++ ) {
+    db.foo.insert( { _id : i } );
+    assert.eq( 1 , db.foo.find( { _id : i } ).itcount() );
+}
+
+var stats = db.runCommand( "connPoolStats" );
+printjson( stats );
+assert( stats.ok );
+
+assert.lte( 0 , stats.totalReused , "totalReused" );
+assert.lte( 0 , stats.totalDestroyed , "totalDestroyed" );
+assert.lt( 0 , stats.maxPerHost , "maxPerHost" );
+
+var reused = 0;
+for ( var host in stats.hosts ) {
+    var h = stats.hosts[host];
+    if ( h.created === undefined )
+        continue;
+    assert.lte( 0 , h.reused , "reused for " + host );
+    assert.lte( 0 , h.destroyed , "destroyed for " + host );
+    reused += h.reused;
+}
+assert.eq( reused , stats.totalReused , "per host reused counts should add up" );
+
+s.stop();
@@ -0,0 +1,65 @@
+// Check the working set estimates of collStats and workingSetStats.
+
+// mongod only
+if ( db.isMaster().msg != "isdbgrid" ) {
+
+    var t = db.jstests_workingset;
+    t.drop();
+
+    for( var i = 0; i < 1000; i++ ) {
+        t.insert( { i:i, s:"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx" } );
+    }
+    t.ensureIndex( { i:1 } );
+    // read every document, so its pages count as touched
+    assert.eq( 1000, t.find().itcount() );
+
+    var stats = db.runCommand( { collStats:t.getName(), workingSet:true } );
+    assert.commandWorked( stats );
+    var ws = stats.workingSet;
+    printjson( ws );
+
+    assert.eq( "thisIsAnEstimate", ws.note );
+    assert.eq( stats.storageSize, ws.storageSize );
+    assert.lt( 0, ws.touchedSize );
+    assert.lte( ws.touchedSize, ws.storageSize );
+    assert.lte( ws.residentSize, ws.storageSize );
+    if ( ws.residentSupported ) {
+        // just written, so in RAM
+        assert.lt( 0, ws.sampledPages );
+        assert.lt( 0, ws.residentSize );
+    }
+    assert( ws.indexes._id_ );
+    assert( ws.indexes.i_1 );
+    assert.lte( ws.indexes.i_1.touchedSize, ws.indexes.i_1.storageSize );
+
+    // a shorter window looks at fewer of the tracked pages
+    var recent = db.runCommand( { collStats:t.getName(), workingSet:60 } ).workingSet;
+    assert.lte( 60, recent.windowSecs );
+    assert.gte( ws.windowSecs, recent.windowSecs );
+    assert.lte( recent.touchedSize, ws.touchedSize );
+
+    // not asked for, not computed
+    assert( !t.stats().workingSet );
+
+    assert.commandFailed( db.runCommand( { workingSetStats:1, samplesPerExtent:0 } ) );
+
+    var all = db.runCommand( { workingSetStats:1, windowSecs:60, scale:1024 } );
+    assert.commandWorked( all );
+    var mine = null;
+    for( var i = 0; i < all.collections.length; i++ ) {
+        if ( i > 0 ) {
+            // most touched first
+            assert.lte( all.collections[i].total.touchedSize,
+                        all.collections[i-1].total.touchedSize );
+        }
+        if ( all.collections[i].ns == t.getFullName() ) {
+            mine = all.collections[i];
+        }
+    }
+    assert( mine, "no " + t.getFullName() + " in workingSetStats" );
+    assert.lte( mine.storageSize, mine.total.storageSize );
+    assert.lte( mine.total.storageSize, all.storageSize );
+    assert( mine.indexes.i_1 );
+
+    t.drop();
+}
@@ -0,0 +1,62 @@
+/* Copyright 2012 10gen Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mongo/bson/mutable/damage_vector.h"
+
+namespace mongo {
+namespace mutablebson {
+
+    namespace {
+        inline bool changed(const char* from, size_t fromSize, const char* to, size_t i) {
+            return i >= fromSize || from[i] != to[i];
+        }
+    } // namespace
+
+    void computeDamages(const char* from, size_t fromSize,
+                        const char* to, size_t toSize,
+                        size_t mergeGap,
+                        DamageVector* damages) {
+        damages->clear();
+
+        size_t i = 0;
+        while (i < toSize) {
+            if (!changed(from, fromSize, to, i)) {
+                ++i;
+                continue;
+            }
+
+            // Extend the range until more than 'mergeGap' unchanged bytes, or the end, are seen.
+            const size_t start = i;
+            size_t end = ++i;
+            while (i < toSize && i - end <= mergeGap) {
+                if (changed(from, fromSize, to, i))
+                    end = i + 1;
+                ++i;
+            }
+
+            damages->push_back(DamageEvent(start, end - start));
+            i = end;
+        }
+    }
+
+    size_t damagedBytes(const DamageVector& damages) {
+        size_t total = 0;
+        for (DamageVector::const_iterator it = damages.begin(); it != damages.end(); ++it)
+            total += it->size;
+        return total;
+    }
+
+} // namespace mutablebson
+} // namespace mongo
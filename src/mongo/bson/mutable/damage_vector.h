@@ -0,0 +1,51 @@
+/* Copyright 2012 10gen Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace mongo {
+namespace mutablebson {
+
+    /**
+     * A byte range of a document that changed.  The new bytes are at the same offset in the new
+     * version of the document, so applying the event is a copy of 'size' bytes at 'offset'.
+     */
+    struct DamageEvent {
+        DamageEvent(size_t offset_, size_t size_) : offset(offset_), size(size_) {}
+        size_t offset;
+        size_t size;
+    };
+
+    typedef std::vector<DamageEvent> DamageVector;
+
+    /**
+     * Computes the byte ranges that must be written over 'from' to turn it into 'to'.  Ranges
+     * separated by at most 'mergeGap' unchanged bytes are reported as one, since each range
+     * written has a fixed cost of its own.  Bytes of 'to' past the end of 'from' are always
+     * damaged; bytes of 'from' past the end of 'to' are left alone.
+     */
+    void computeDamages(const char* from, size_t fromSize,
+                        const char* to, size_t toSize,
+                        size_t mergeGap,
+                        DamageVector* damages);
+
+    /** @return the total number of bytes covered by 'damages'. */
+    size_t damagedBytes(const DamageVector& damages);
+
+} // namespace mutablebson
+} // namespace mongo
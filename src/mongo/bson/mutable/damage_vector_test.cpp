@@ -0,0 +1,122 @@
+/* Copyright 2012 10gen Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "mongo/bson/mutable/damage_vector.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+    using mongo::mutablebson::DamageVector;
+    using mongo::mutablebson::computeDamages;
+    using mongo::mutablebson::damagedBytes;
+
+    void damages(const std::string& from, const std::string& to, size_t mergeGap,
+                 DamageVector* result) {
+        computeDamages(from.data(), from.size(), to.data(), to.size(), mergeGap, result);
+    }
+
+    /** Writes 'damages' of 'to' over 'from'. */
+    std::string apply(std::string from, const std::string& to, const DamageVector& damages) {
+        from.resize(std::max(from.size(), to.size()));
+        for (DamageVector::const_iterator it = damages.begin(); it != damages.end(); ++it)
+            from.replace(it->offset, it->size, to, it->offset, it->size);
+        return from.substr(0, to.size());
+    }
+
+    TEST(DamageVector, Unchanged) {
+        DamageVector d;
+        damages("abcdef", "abcdef", 4, &d);
+        ASSERT_EQUALS(0U, d.size());
+        damages("", "", 4, &d);
+        ASSERT_EQUALS(0U, d.size());
+    }
+
+    TEST(DamageVector, SingleRange) {
+        DamageVector d;
+        damages("abcdefgh", "abXYefgh", 0, &d);
+        ASSERT_EQUALS(1U, d.size());
+        ASSERT_EQUALS(2U, d[0].offset);
+        ASSERT_EQUALS(2U, d[0].size);
+    }
+
+    TEST(DamageVector, MergesShortGaps) {
+        DamageVector d;
+        damages("abcdefghijkl", "Xbcdefghijk?", 2, &d);
+        ASSERT_EQUALS(2U, d.size());
+        ASSERT_EQUALS(2U, damagedBytes(d));
+
+        damages("abcdefghijkl", "aXcXefghijkl", 2, &d);
+        ASSERT_EQUALS(1U, d.size());
+        ASSERT_EQUALS(1U, d[0].offset);
+        ASSERT_EQUALS(3U, d[0].size);
+    }
+
+    TEST(DamageVector, Growth) {
+        DamageVector d;
+        damages("abc", "abcdef", 4, &d);
+        ASSERT_EQUALS(1U, d.size());
+        ASSERT_EQUALS(3U, d[0].offset);
+        ASSERT_EQUALS(3U, d[0].size);
+    }
+
+    TEST(DamageVector, Shrink) {
+        DamageVector d;
+        damages("abcdef", "abX", 4, &d);
+        ASSERT_EQUALS(1U, d.size());
+        ASSERT_EQUALS(2U, d[0].offset);
+        ASSERT_EQUALS(1U, d[0].size);
+    }
+
+    TEST(DamageVector, SmallSetOnLargeDocument) {
+        mongo::BSONObjBuilder before;
+        mongo::BSONObjBuilder after;
+        for (int i = 0; i < 1000; ++i) {
+            before.append(mongo::BSONObjBuilder::numStr(i), i);
+            after.append(mongo::BSONObjBuilder::numStr(i), i == 500 ? -1 : i);
+        }
+        mongo::BSONObj a = before.obj();
+        mongo::BSONObj b = after.obj();
+
+        DamageVector d;
+        computeDamages(a.objdata(), a.objsize(), b.objdata(), b.objsize(), 16, &d);
+        ASSERT_EQUALS(1U, d.size());
+        ASSERT_LESS_THAN_OR_EQUALS(damagedBytes(d), 4U);
+        std::string patched = apply(std::string(a.objdata(), a.objsize()),
+                                    std::string(b.objdata(), b.objsize()), d);
+        ASSERT_EQUALS(0, memcmp(patched.data(), b.objdata(), b.objsize()));
+    }
+
+    TEST(DamageVector, ApplyingGivesTarget) {
+        const char* pairs[][2] = {
+            { "the quick brown fox", "the quick red fox!" },
+            { "aaaaaaaaaa", "abababababab" },
+            { "0123456789", "" },
+            { "", "new" },
+        };
+        for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); ++i) {
+            for (size_t gap = 0; gap < 4; ++gap) {
+                DamageVector d;
+                damages(pairs[i][0], pairs[i][1], gap, &d);
+                ASSERT_EQUALS(std::string(pairs[i][1]), apply(pairs[i][0], pairs[i][1], d));
+            }
+        }
+    }
+
+} // unnamed namespace
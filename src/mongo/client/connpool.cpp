@@ -37,6 +37,7 @@ namespace mongo {
             StoredConnection sc = _pool.top();
             delete sc.conn;
             _pool.pop();
+            _destroyed++;
         }
     }
 
@@ -44,6 +45,7 @@ namespace mongo {
         if ( _pool.size() >= _maxPerHost ) {
             pool->onDestroy( c );
             delete c;
+            _destroyed++;
         }
         else {
             _pool.push(c);
@@ -61,11 +63,13 @@ namespace mongo {
             if ( ! sc.ok( now ) )  {
                 pool->onDestroy( sc.conn );
                 delete sc.conn;
+                _destroyed++;
                 continue;
             }
             
             verify( sc.conn->getSoTimeout() == socketTimeout );
 
+            _reused++;
             return sc.conn;
 
         }
@@ -94,6 +98,7 @@ namespace mongo {
                     c.conn->getServerAddress() << ": " << causedBy(e) << endl;
                 delete c.conn;
                 c.conn = NULL;
+                _destroyed++;
             }
             if ( alive ) {
                 c.conn->clearAuthenticationTable();
@@ -114,10 +119,13 @@ namespace mongo {
             StoredConnection c = _pool.top();
             _pool.pop();
             
-            if ( c.ok( now ) )
+            if ( c.ok( now ) ) {
                 all.push_back( c );
-            else
+            }
+            else {
                 stale.push_back( c.conn );
+                _destroyed++;
+            }
         }
 
         for ( size_t i=0; i<all.size(); i++ ) {
@@ -225,6 +233,10 @@ namespace mongo {
 
     void DBConnectionPool::release(const string& host, DBClientBase *c) {
         if ( c->isFailed() ) {
+            {
+                scoped_lock L(_mutex);
+                _pools[PoolKey(host,c->getSoTimeout())].destroyedOne();
+            }
             onDestroy( c );
             delete c;
             return;
@@ -293,6 +305,8 @@ namespace mongo {
 
         int avail = 0;
         long long created = 0;
+        long long reused = 0;
+        long long destroyed = 0;
 
 
         map<ConnectionString::ConnectionType,long long> createdByType;
@@ -311,10 +325,14 @@ namespace mongo {
                 BSONObjBuilder temp( bb.subobjStart( s ) );
                 temp.append( "available" , i->second.numAvailable() );
                 temp.appendNumber( "created" , i->second.numCreated() );
+                temp.appendNumber( "reused" , i->second.numReused() );
+                temp.appendNumber( "destroyed" , i->second.numDestroyed() );
                 temp.done();
 
                 avail += i->second.numAvailable();
                 created += i->second.numCreated();
+                reused += i->second.numReused();
+                destroyed += i->second.numDestroyed();
 
                 long long& x = createdByType[i->second.type()];
                 x += i->second.numCreated();
@@ -356,6 +374,9 @@ namespace mongo {
 
         b.append( "totalAvailable" , avail );
         b.appendNumber( "totalCreated" , created );
+        b.appendNumber( "totalReused" , reused );
+        b.appendNumber( "totalDestroyed" , destroyed );
+        b.append( "maxPerHost" , PoolForHost::getMaxPerHost() );
     }
 
     bool DBConnectionPool::serverNameCompare::operator()( const string& a , const string& b ) const{
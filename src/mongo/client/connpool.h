@@ -34,11 +34,13 @@ namespace mongo {
     class PoolForHost {
     public:
         PoolForHost()
-            : _created(0) {}
+            : _created(0), _reused(0), _destroyed(0) {}
 
         PoolForHost( const PoolForHost& other ) {
             verify(other._pool.size() == 0);
             _created = other._created;
+            _reused = other._reused;
+            _destroyed = other._destroyed;
             verify( _created == 0 );
         }
 
@@ -49,6 +51,15 @@ namespace mongo {
         void createdOne( DBClientBase * base );
         long long numCreated() const { return _created; }
 
+        /** @return number of times a pooled connection was handed out instead of a new one */
+        long long numReused() const { return _reused; }
+
+        /** @return number of connections closed by the pool (idle, over capacity or failed) */
+        long long numDestroyed() const { return _destroyed; }
+
+        /** records a connection that was discarded rather than returned to the pool */
+        void destroyedOne() { _destroyed++; }
+
         ConnectionString::ConnectionType type() const { verify(_created); return _type; }
 
         /**
@@ -81,6 +92,8 @@ namespace mongo {
         std::stack<StoredConnection> _pool;
         
         long long _created;
+        long long _reused;
+        long long _destroyed;
         ConnectionString::ConnectionType _type;
 
         static unsigned _maxPerHost;
@@ -113,6 +113,11 @@ namespace mongo {
                             HostAndPort* lastHost /* in/out */,
                             bool* isPrimarySelected) {
         HostAndPort fallbackHost;
+        bool fallbackIsPrimary = false;
+
+        // the local candidate with the lowest readCost; ties go to the first one found
+        // in round robin order
+        int bestLocalIndex = -1;
 
         // Implicit: start from index 0 if lastHost doesn't exist anymore
         size_t nextNodeIndex = 0;
@@ -142,19 +147,29 @@ namespace mongo {
             if (node.matchesTag(readPreferenceTag)) {
                 // found an ok candidate; may not be local.
                 fallbackHost = node.addr;
-                *isPrimarySelected = node.ismaster;
-
-                if (node.isLocalSecondary(localThresholdMillis)) {
-                    // found a local node.  return early.
-                    LOG(2) << "dbclient_rs _selectNode found local secondary for queries: "
-                           << nextNodeIndex << ", ping time: " << node.pingTimeMillis << endl;
-                    *lastHost = fallbackHost;
-                    return fallbackHost;
+                fallbackIsPrimary = node.ismaster;
+
+                if (node.isLocalSecondary(localThresholdMillis) &&
+                        (bestLocalIndex < 0 ||
+                         node.readCost() < nodes[bestLocalIndex].readCost())) {
+                    bestLocalIndex = static_cast<int>(nextNodeIndex);
                 }
             }
         }
 
+        if (bestLocalIndex >= 0) {
+            const ReplicaSetMonitor::Node& node = nodes[bestLocalIndex];
+            LOG(2) << "dbclient_rs _selectNode found local secondary for queries: "
+                   << bestLocalIndex << ", ping time: " << node.pingTimeMillis
+                   << ", read latency micros: " << node.readLatencyMicros
+                   << ", in flight reads: " << node.inFlightReads << endl;
+            *isPrimarySelected = node.ismaster;
+            *lastHost = node.addr;
+            return node.addr;
+        }
+
         if (!fallbackHost.empty()) {
+            *isPrimarySelected = fallbackIsPrimary;
             *lastHost = fallbackHost;
         }
 
@@ -556,6 +571,63 @@ namespace mongo {
         }
     }
 
+    void ReplicaSetMonitor::notifyReadStart( const HostAndPort& server ) {
+        scoped_lock lk( _lock );
+        int x = _find_inlock( server );
+        if ( x >= 0 ) {
+            _nodes[x].inFlightReads++;
+        }
+    }
+
+    void ReplicaSetMonitor::notifyReadEnd( const HostAndPort& server,
+                                           long long micros,
+                                           bool succeeded ) {
+        scoped_lock lk( _lock );
+        int x = _find_inlock( server );
+        if ( x < 0 ) {
+            // the node was removed from the set while the read was in flight
+            return;
+        }
+
+        Node& node = _nodes[x];
+        if ( node.inFlightReads > 0 ) {
+            node.inFlightReads--;
+        }
+
+        if ( ! succeeded ) {
+            return;
+        }
+
+        if ( node.readLatencyMicros == 0 ) {
+            node.readLatencyMicros = static_cast<double>( micros );
+        }
+        else {
+            // same smoothing as the ping time: move 1/4th of the delta
+            node.readLatencyMicros += ( micros - node.readLatencyMicros ) / 4;
+        }
+    }
+
+    bool ReplicaSetMonitor::hasMuchFasterSecondary( const HostAndPort& server ) const {
+        scoped_lock lk( _lock );
+        int x = _find_inlock( server );
+        if ( x < 0 ) {
+            return false;
+        }
+
+        const double cost = _nodes[x].readCost();
+        for ( size_t i = 0; i < _nodes.size(); i++ ) {
+            if ( static_cast<int>( i ) == x || ! _nodes[i].okForSecondaryQueries() ) {
+                continue;
+            }
+
+            if ( _nodes[i].readCost() * SlowNodeCostFactor < cost ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     void ReplicaSetMonitor::_checkStatus( const string& hostAddr ) {
         BSONObj status;
 
@@ -1042,6 +1114,8 @@ namespace mongo {
             builder.append("hidden", node.hidden);
             builder.append("secondary", node.secondary);
             builder.append("pingTimeMillis", node.pingTimeMillis);
+            builder.append("readLatencyMicros", node.readLatencyMicros);
+            builder.append("inFlightReads", node.inFlightReads);
 
             const BSONElement& tagElem = node.lastIsMaster["tags"];
             if (tagElem.ok() && tagElem.isABSONObj()) {
@@ -1326,6 +1400,36 @@ namespace mongo {
     ReplicaSetMonitor::ConfigChangeHook ReplicaSetMonitor::_hook;
     int ReplicaSetMonitor::_maxFailedChecks = 30; // At 1 check every 10 seconds, 30 checks takes 5 minutes
 
+    /**
+     * Reports a read sent to a replica set member to the set's monitor, so that the round trip
+     * time and the number of reads outstanding per node can be used when selecting nodes.
+     */
+    class ScopedReadTracker : boost::noncopyable {
+    public:
+        ScopedReadTracker( ReplicaSetMonitorPtr monitor, const HostAndPort& host )
+            : _monitor( monitor ), _host( host ), _done( false ) {
+            _monitor->notifyReadStart( _host );
+        }
+
+        ~ScopedReadTracker() {
+            if ( ! _done ) {
+                _monitor->notifyReadEnd( _host, _timer.micros(), false );
+            }
+        }
+
+        /** call once the reply to the read was received */
+        void done() {
+            _done = true;
+            _monitor->notifyReadEnd( _host, _timer.micros(), true );
+        }
+
+    private:
+        ReplicaSetMonitorPtr _monitor;
+        const HostAndPort _host;
+        Timer _timer;
+        bool _done;
+    };
+
     // --------------------------------
     // ----- DBClientReplicaSet ---------
     // --------------------------------
@@ -1393,7 +1497,19 @@ namespace mongo {
             return false;
         }
 
-        return _lastSlaveOkConn && monitor->isHostCompatible(_lastSlaveOkHost, preference, tags);
+        if (!_lastSlaveOkConn ||
+                !monitor->isHostCompatible(_lastSlaveOkHost, preference, tags)) {
+            return false;
+        }
+
+        // Stop sticking to a secondary that has become much slower than its peers since it
+        // was selected, rather than waiting for the next periodic check to notice.
+        if (_lastSlaveOkConn != _master && monitor->hasMuchFasterSecondary(_lastSlaveOkHost)) {
+            LOG(1) << "dbclient_rs moving reads away from slow node " << _lastSlaveOkHost << endl;
+            return false;
+        }
+
+        return true;
     }
 
     void DBClientReplicaSet::_auth( DBClientConnection * conn ) {
@@ -1516,9 +1632,11 @@ namespace mongo {
                         break;
                     }
 
+                    ScopedReadTracker tracker(_getMonitor(), _lastSlaveOkHost);
                     auto_ptr<DBClientCursor> cursor = conn->query(ns, query,
                             nToReturn, nToSkip, fieldsToReturn, queryOptions,
                             batchSize);
+                    tracker.done();
 
                     return checkSlaveQueryResult(cursor);
                 }
@@ -1554,7 +1672,11 @@ namespace mongo {
                         break;
                     }
 
-                    return conn->findOne(ns,query,fieldsToReturn,queryOptions);
+                    ScopedReadTracker tracker(_getMonitor(), _lastSlaveOkHost);
+                    BSONObj result = conn->findOne(ns,query,fieldsToReturn,queryOptions);
+                    tracker.done();
+
+                    return result;
                 }
                 catch (const DBException &dbExcep) {
                     LOG(1) << "can't findone replica set slave " << _lastSlaveOkHost
@@ -62,7 +62,9 @@ namespace mongo {
                 ismaster(false),
                 secondary( false ),
                 hidden( false ),
-                pingTimeMillis( 0 ) {
+                pingTimeMillis( 0 ),
+                readLatencyMicros( 0 ),
+                inFlightReads( 0 ) {
             }
 
             bool okForSecondaryQueries() const {
@@ -98,6 +100,15 @@ namespace mongo {
                 return pingTimeMillis < threshold;
             }
 
+            /**
+             * @return the relative cost of routing one more read to this node, based on the
+             *     smoothed latency of the reads this process sent to it and the number of reads
+             *     still outstanding. Nodes that were never read from all cost the same.
+             */
+            double readCost() const {
+                return ( readLatencyMicros + 1 ) * ( inFlightReads + 1 );
+            }
+
             /**
              * Checks whether this nodes is compatible with the given readPreference and
              * tag. Compatibility check is strict in the sense that secondary preferred
@@ -131,8 +142,18 @@ namespace mongo {
 
             int pingTimeMillis;
 
+            // smoothed round trip time of reads sent to this node by this process, 0 if none
+            double readLatencyMicros;
+
+            // reads sent to this node by this process that have not completed yet
+            int inFlightReads;
+
         };
 
+        // a node whose readCost() exceeds this many times that of another eligible
+        // secondary is considered slow, and reads stop sticking to it
+        static const int SlowNodeCostFactor = 4;
+
         /**
          * Selects the right node given the nodes to pick from and the preference.
          *
@@ -243,6 +264,26 @@ namespace mongo {
          */
         void notifySlaveFailure( const HostAndPort& server );
 
+        /**
+         * Notifies the monitor that a read is about to be sent to the given server.
+         * Must be paired with a call to notifyReadEnd.
+         */
+        void notifyReadStart( const HostAndPort& server );
+
+        /**
+         * Notifies the monitor that a read sent to the given server completed.
+         *
+         * @param micros the round trip time of the read
+         * @param succeeded if false, the latency is not folded into the node's average
+         */
+        void notifyReadEnd( const HostAndPort& server, long long micros, bool succeeded );
+
+        /**
+         * @return true if another ok secondary currently has a readCost() at least
+         *     SlowNodeCostFactor times lower than the given server's.
+         */
+        bool hasMuchFasterSecondary( const HostAndPort& server ) const;
+
         /**
          * checks for current master and new secondaries
          */
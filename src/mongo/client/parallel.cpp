@@ -763,6 +763,23 @@ namespace mongo {
         }
     }
     
+    /** @return 'query' with its filter, wrapped in query / $query or not, replaced by 'filter' */
+    static BSONObj replaceQueryFilter( const BSONObj& query , const BSONObj& filter ) {
+        bool hasDollar;
+        if ( ! Query( query ).isComplex( &hasDollar ) )
+            return filter;
+
+        const char* filterField = hasDollar ? "$query" : "query";
+        BSONObjBuilder b;
+        BSONForEach( e , query ) {
+            if ( str::equals( e.fieldName() , filterField ) )
+                b.append( filterField , filter );
+            else
+                b.append( e );
+        }
+        return b.obj();
+    }
+
     void ParallelSortClusteredCursor::startInit() {
 
         bool returnPartial = ( _qSpec.options() & QueryOption_PartialResults );
@@ -786,6 +803,7 @@ namespace mongo {
 
         set<Shard> todoStorage;
         set<Shard>& todo = todoStorage;
+        map<Shard,BSONObj> shardQueries;
         string vinfo;
 
         if( isVersioned() ){
@@ -810,6 +828,16 @@ namespace mongo {
             if( manager ) manager->getShardsForQuery( todo, specialFilter ? _cInfo.cmdFilter : _qSpec.filter() );
             else if( primary ) todo.insert( *primary );
 
+            // Only send each shard the part of a shard key $in it actually owns
+            if( manager && ! isCommand() && todo.size() > 1 ){
+                map<Shard,BSONObj> shardFilters;
+                if( manager->splitInQueryByShard( _qSpec.filter(), shardFilters ) ){
+                    for( map<Shard,BSONObj>::iterator i = shardFilters.begin(); i != shardFilters.end(); ++i ){
+                        shardQueries[ i->first ] = replaceQueryFilter( _qSpec.query(), i->second );
+                    }
+                }
+            }
+
             // Close all cursors on extra shards first, as these will be invalid
             for( map< Shard, PCMData >::iterator i = _cursorMap.begin(), end = _cursorMap.end(); i != end; ++i ){
 
@@ -895,6 +923,9 @@ namespace mongo {
 
                 const string& ns = _qSpec.ns();
 
+                map<Shard,BSONObj>::const_iterator shardQuery = shardQueries.find( shard );
+                const BSONObj query = shardQuery == shardQueries.end() ? _qSpec.query() : shardQuery->second;
+
                 // Setup cursor
                 if( ! state->cursor ){
 
@@ -902,7 +933,7 @@ namespace mongo {
                     // or if the number of shards to query is > 1
                     if( ( isVersioned() && ! primary ) || _qShards.size() > 1 ){
 
-                        state->cursor.reset( new DBClientCursor( state->conn->get(), ns, _qSpec.query(),
+                        state->cursor.reset( new DBClientCursor( state->conn->get(), ns, query,
                                                                  isCommand() ? 1 : 0, // nToReturn (0 if query indicates multi)
                                                                  0, // nToSkip
                                                                  // Does this need to be a ptr?
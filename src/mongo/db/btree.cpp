@@ -619,6 +619,27 @@ namespace mongo {
         }
     }
 
+    template< class V >
+    DiskLoc BtreeBucket<V>::appendLoc(const DiskLoc thisLoc, const Key& key, const Ordering &order) const {
+        // one compare at the root rules out most non increasing keys before we walk anything
+        if ( this->n == 0 || key.woCompare(keyNode(this->n-1).key, order) <= 0 )
+            return DiskLoc();
+
+        DiskLoc loc = thisLoc;
+        const BtreeBucket *b = this;
+        while ( !b->nextChild.isNull() ) {
+            loc = b->nextChild;
+            b = loc.btree<V>();
+            globalIndexCounters.btree( (char*)b );
+        }
+
+        if ( b == this )
+            return loc;
+        if ( b->n == 0 || key.woCompare(b->keyNode(b->n-1).key, order) <= 0 )
+            return DiskLoc();
+        return loc;
+    }
+
     /**
      * NOTE Currently the Ordering implementation assumes a compound index will
      * not have more keys than an unsigned variable has bits.  The same
@@ -1822,6 +1843,14 @@ namespace mongo {
             problem() << "ERROR: key too large len:" << c.key.dataSize() << " max:" << this->KeyMax << ' ' << c.key.dataSize() << ' ' << c.idx.indexNamespace() << endl;
             return; // op=Nothing
         }
+        DiskLoc tail = appendLoc(thisLoc, c.key, c.order);
+        if ( !tail.isNull() ) {
+            c.bLoc = tail;
+            c.b = tail.btree<V>();
+            c.pos = c.b->n;
+            c.op = IndexInsertionContinuation::InsertHere;
+            return;
+        }
         insertStepOne(thisLoc, c, dupsAllowed);
     }
 
@@ -1844,7 +1873,15 @@ namespace mongo {
 
         int x;
         try {
-            x = _insert(thisLoc, recordLoc, key, order, dupsAllowed, DiskLoc(), DiskLoc(), idx);
+            DiskLoc tail = appendLoc(thisLoc, key, order);
+            if ( !tail.isNull() ) {
+                const BtreeBucket<V> *b = tail.btree<V>();
+                b->insertHere(tail, b->n, recordLoc, key, order, DiskLoc(), DiskLoc(), idx);
+                x = 0;
+            }
+            else {
+                x = _insert(thisLoc, recordLoc, key, order, dupsAllowed, DiskLoc(), DiskLoc(), idx);
+            }
             this->assertValid( order );
         }
         catch( ... ) { 
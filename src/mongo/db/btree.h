@@ -961,6 +961,17 @@ namespace mongo {
         void insertStepOne(
                 DiskLoc thisLoc, IndexInsertionContinuationImpl<V>& c, bool dupsAllowed) const;
 
+        /**
+         * Fast path for keys arriving in increasing order (ObjectId _id, timestamps, bulk
+         * loads of sorted data).  Follows the right spine down from thisLoc, one pointer read
+         * per level instead of a binary search, and compares 'key' with the largest key in the
+         * tree.
+         * @return the bottom bucket of the right spine if 'key' sorts strictly after every
+         *         key in the tree, in which case it belongs at position n of that bucket;
+         *         a null DiskLoc otherwise, and the caller does the usual descent.
+         */
+        DiskLoc appendLoc(const DiskLoc thisLoc, const Key& key, const Ordering &order) const;
+
         bool find(const IndexDetails& idx, const Key& key, const DiskLoc &recordLoc, const Ordering &order, int& pos, bool assertIfDup) const;        
         static bool customFind( int l, int h, const BSONObj &keyBegin, int keyBeginLen, bool afterKey, const vector< const BSONElement * > &keyEnd, const vector< bool > &keyEndInclusive, const Ordering &order, int direction, DiskLoc &thisLoc, int &keyOfs, pair< DiskLoc, int > &bestParent ) ;
         static void findLargestKey(const DiskLoc& thisLoc, DiskLoc& largestLoc, int& largestKey);
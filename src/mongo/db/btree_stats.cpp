@@ -28,12 +28,7 @@ namespace mongo {
 
         _memSupported = ProcessInfo().blockCheckSupported();
 
-        _btreeMemHits = 0;
-        _btreeMemMisses = 0;
-        _btreeAccesses = 0;
-
-
-        _maxAllowed = ( numeric_limits< long long >::max() ) / 2;
+        _maxAllowed = ( numeric_limits< long long >::max() ) / 2 / StripeCount;
         _resets = 0;
     }
 
@@ -45,22 +40,23 @@ namespace mongo {
             return BSON( "note" << "not supported on this platform" );
         }
         
+        long long accesses = _counters.get( ACCESSES );
+        long long misses = _counters.get( MISSES );
+
         BSONObjBuilder bb;
-        bb.appendNumber( "accesses" , _btreeAccesses );
-        bb.appendNumber( "hits" , _btreeMemHits );
-        bb.appendNumber( "misses" , _btreeMemMisses );
+        bb.appendNumber( "accesses" , accesses );
+        bb.appendNumber( "hits" , _counters.get( HITS ) );
+        bb.appendNumber( "misses" , misses );
 
         bb.append( "resets" , _resets );
 
-        bb.append( "missRatio" , (_btreeAccesses ? (_btreeMemMisses / (double)_btreeAccesses) : 0) );
+        bb.append( "missRatio" , (accesses ? (misses / (double)accesses) : 0) );
 
         return bb.obj();        
     }
 
     void IndexCounters::_roll() {
-        _btreeAccesses = 0;
-        _btreeMemMisses = 0;
-        _btreeMemHits = 0;
+        _counters.reset();
         _resets++;
     }
 
@@ -22,6 +22,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/pdfile.h"
 #include "mongo/db/record.h"
+#include "mongo/util/concurrency/striped_counter.h"
 #include "mongo/util/processinfo.h"
 
 namespace mongo {
@@ -46,16 +47,13 @@ namespace mongo {
         }
 
         void btree( bool memHit ) {
-            if ( memHit )
-                _btreeMemHits++;
-            else
-                _btreeMemMisses++;
-            if ( _btreeAccesses++ > _maxAllowed )
+            _counters.add( memHit ? HITS : MISSES , 1 );
+            if ( _counters.add( ACCESSES , 1 ) > _maxAllowed )
                 _roll();
 
         }
-        void btreeHit() { _btreeMemHits++; _btreeAccesses++; }
-        void btreeMiss() { _btreeMemMisses++; _btreeAccesses++; }
+        void btreeHit() { _counters.add( HITS , 1 ); _counters.add( ACCESSES , 1 ); }
+        void btreeMiss() { _counters.add( MISSES , 1 ); _counters.add( ACCESSES , 1 ); }
 
     private:
         
@@ -64,11 +62,10 @@ namespace mongo {
         bool _memSupported;
 
         int _resets;
-        long long _maxAllowed;
+        long long _maxAllowed; // per stripe
 
-        long long _btreeMemMisses;
-        long long _btreeMemHits;
-        long long _btreeAccesses;
+        enum { HITS , MISSES , ACCESSES , NCOUNTERS };
+        StripedCounters<NCOUNTERS> _counters;
     };
 
     extern IndexCounters globalIndexCounters;
@@ -592,6 +592,8 @@ namespace mongo {
         fastmodinsert = false;
         upsert = false;
         keyUpdates = 0;  // unsigned, so -1 not possible
+        arenaAllocs = -1;
+        arenaBytes = -1;
         
         exceptionInfo.reset();
         
@@ -638,6 +640,8 @@ namespace mongo {
         OPDEBUG_TOSTRING_HELP_BOOL( fastmodinsert );
         OPDEBUG_TOSTRING_HELP_BOOL( upsert );
         OPDEBUG_TOSTRING_HELP( keyUpdates );
+        OPDEBUG_TOSTRING_HELP( arenaAllocs );
+        OPDEBUG_TOSTRING_HELP( arenaBytes );
         
         if ( extra.len() )
             s << " " << extra.str();
@@ -653,6 +657,7 @@ namespace mongo {
         
         s << " ";
         curop.lockStat().report( s );
+        curop.waitReport( s );
         
         OPDEBUG_TOSTRING_HELP( nreturned );
         if ( responseLength > 0 )
@@ -729,9 +734,12 @@ namespace mongo {
         OPDEBUG_APPEND_BOOL( fastmodinsert );
         OPDEBUG_APPEND_BOOL( upsert );
         OPDEBUG_APPEND_NUMBER( keyUpdates );
+        OPDEBUG_APPEND_NUMBER( arenaAllocs );
+        OPDEBUG_APPEND_NUMBER( arenaBytes );
 
         b.appendNumber( "numYield" , curop.numYields() );
         b.append( "lockStats" , curop.lockStat().report() );
+        b.append( "waitMicros" , curop.waitReport() );
 
         if ( ! exceptionInfo.empty() )
             exceptionInfo.append( b , "exception" , "exceptionCode" );
@@ -584,8 +584,10 @@ namespace mongo {
                           << endl;
             }
 
-            if ( rec )
+            if ( rec ) {
+                CurOp::StageScope faulting( cc().curop() , OpStagePageFault );
                 rec->touch();
+            }
 
             lk.reset(0); // need to release this before dbtempreleasecond
         }
@@ -794,8 +796,7 @@ namespace mongo {
                     log() << " connections:" << Listener::globalTicketHolder.used();
                     if (theReplSet) {
                         log() << " replication threads:" << 
-                            ReplSetImpl::replWriterThreadCount + 
-                            ReplSetImpl::replPrefetcherThreadCount;
+                            theReplSet->getReplExecutor().threads();
                     }
                     last = now;
                     mlast = m;
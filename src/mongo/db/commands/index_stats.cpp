@@ -34,6 +34,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/kill_current_op.h"
 #include "mongo/db/namespace_details.h"
+#include "mongo/db/working_set.h"
 #include "mongo/util/descriptive_stats.h"
 
 namespace mongo {
@@ -42,8 +43,12 @@ namespace mongo {
      * Holds operation parameters.
      */
     struct IndexStatsParams {
+        IndexStatsParams() : workingSet(false), workingSetWindowSecs(0) {}
+
         string indexName;
         vector<int> expandNodes;
+        bool workingSet;
+        int workingSetWindowSecs;
     };
 
     /**
@@ -374,6 +379,16 @@ namespace mongo {
                << "keyPattern" << details->keyPattern()
                << "storageNs" << details->indexNamespace();
 
+        // before the walk, which pages in the whole btree
+        const NamespaceDetails* storage = nsdetails(details->indexNamespace().c_str());
+        if (params.workingSet && storage) {
+            WorkingSetEstimator estimator(params.workingSetWindowSecs);
+            BSONObjBuilder workingSet(result.subobjStart("workingSet"));
+            estimator.appendInfo(workingSet);
+            estimator.estimate(storage).appendTo(workingSet, 1);
+            workingSet.doneFast();
+        }
+
         scoped_ptr<BtreeInspector> inspector(NULL);
         switch (details->version()) {
           case 1: inspector.reset(new BtreeInspectorV1(params.expandNodes)); break;
@@ -406,6 +421,8 @@ namespace mongo {
      *       isIdKey: <true if this is the default _id index>,
      *       keyPattern: <bson object describing the key pattern>,
      *       storageNs: <namespace of the index's underlying storage>,
+     * (opt) workingSet: <estimate of how much of the storage is in the working set, taken before
+     *                    the walk, only with {workingSet: ...}; see WorkingSetEstimator>,
      *       bucketBodyBytes: <bytes available for keynodes and bson objects in the bucket's body>,
      *       depth: <index depth (root excluded)>
      *       overall: { (statistics for the entire tree)
@@ -479,7 +496,9 @@ namespace mongo {
               << "of the nodes to be expanded, {expandNodes: [...]}. "
               << "For example, {indexStats: 'collection', index: '_id', expandNodes: [0, 4]} "
               << "aggregates statistics for the _id index for 'collection' and expands root "
-              << "and the fifth child of root.";
+              << "and the fifth child of root. "
+              << "{workingSet: true} or {workingSet: <window in seconds>} also estimates how much "
+              << "of the index is in the working set, before the walk pages it all in.";
         }
 
         virtual LockType locktype() const { return READ; }
@@ -523,6 +542,13 @@ namespace mongo {
                 }
             }
 
+            // { workingSet: true } or { workingSet: <window in seconds> }
+            BSONElement workingSet = cmdObj["workingSet"];
+            if (workingSet.trueValue()) {
+                params.workingSet = true;
+                params.workingSetWindowSecs = workingSet.isNumber() ? workingSet.numberInt() : 0;
+            }
+
             BSONObjBuilder resultBuilder;
             if (!runInternal(nsd, params, errmsg, resultBuilder))
                 return false;
@@ -24,6 +24,51 @@ namespace mongo {
 
     // todo : move more here
 
+    const char* opStageName( OpStage stage ) {
+        switch ( stage ) {
+        case OpStageOther: return "other";
+        case OpStageLockWait: return "lockWait";
+        case OpStagePageFault: return "pageFault";
+        case OpStageScan: return "scan";
+        case OpStageMatch: return "match";
+        case OpStageWrite: return "write";
+        case OpStageJournalWait: return "journalWait";
+        case OpStageYield: return "yield";
+        default: return "unknown";
+        }
+    }
+
+    CurOp::StageScope::StageScope( OpStage stage ) : _op( 0 ) {
+        Client* c = currentClient.get();
+        if ( c )
+            _op = c->curop();
+        _enter( stage );
+    }
+
+    void CurOp::StageScope::_enter( OpStage stage ) {
+        _stage = stage;
+        _prev = OpStageOther;
+        _start = 0;
+        if ( ! _op )
+            return;
+        _prev = _op->stage();
+        _op->setStage( stage );
+        if ( isWaitStage( stage ) )
+            _start = curTimeMicros64();
+    }
+
+    CurOp::StageScope::~StageScope() {
+        if ( ! _op )
+            return;
+        _op->setStage( _prev );
+        if ( _start ) {
+            long long micros = curTimeMicros64() - _start;
+            _op->_waitMicros[_stage] += micros;
+            if ( isWaitStage( _prev ) )
+                _op->_waitMicros[_prev] -= micros;
+        }
+    }
+
     CurOp::CurOp( Client * client , CurOp * wrapped ) : 
         _client(client), 
         _wrapped(wrapped) 
@@ -50,6 +95,8 @@ namespace mongo {
         _killPending.store(0);
         killCurrentOp.notifyAllWaiters();
         _numYields = 0;
+        _stage = OpStageOther;
+        memset( _waitMicros , 0 , sizeof( _waitMicros ) );
         _expectedLatencyMs = 0;
         _lockStat.reset();
     }
@@ -187,10 +234,35 @@ namespace mongo {
         
         b.append( "numYields" , _numYields );
         b.append( "lockStats" , _lockStat.report() );
+        b.append( "waitMicros" , waitReport() );
 
         return b.obj();
     }
 
+    BSONObj CurOp::waitReport() const {
+        BSONObjBuilder b;
+        for ( int i = 0; i < OpStageCount; i++ ) {
+            if ( _waitMicros[i] > 0 )
+                b.appendNumber( opStageName( static_cast<OpStage>( i ) ) , _waitMicros[i] );
+        }
+        return b.obj();
+    }
+
+    void CurOp::waitReport( StringBuilder& builder ) const {
+        bool prefixPrinted = false;
+        for ( int i = 0; i < OpStageCount; i++ ) {
+            if ( _waitMicros[i] <= 0 )
+                continue;
+
+            if ( ! prefixPrinted ) {
+                builder << " waits(micros)";
+                prefixPrinted = true;
+            }
+
+            builder << ' ' << opStageName( static_cast<OpStage>( i ) ) << ':' << _waitMicros[i];
+        }
+    }
+
     void CurOp::setKillWaiterFlags() {
         for (size_t i = 0; i < _notifyList.size(); ++i) 
             *(_notifyList[i]) = true;
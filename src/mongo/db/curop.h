@@ -33,6 +33,21 @@ namespace mongo {
 
     class CurOp;
 
+    /** What an operation is doing, as seen by the OpSampler. */
+    enum OpStage {
+        OpStageOther = 0,
+        OpStageLockWait,
+        OpStagePageFault,
+        OpStageScan,        // advancing a cursor, over an index or a collection
+        OpStageMatch,       // loading and matching a document
+        OpStageWrite,       // writing a record and its index keys
+        OpStageJournalWait,
+        OpStageYield,       // from releasing the lock to getting it back
+        OpStageCount
+    };
+
+    const char* opStageName( OpStage stage );
+
     /* lifespan is different than CurOp because of recursives with DBDirectClient */
     class OpDebug {
     public:
@@ -85,6 +100,10 @@ namespace mongo {
         bool upsert;         // true if the update actually did an insert
         int keyUpdates;
 
+        // per operation scratch memory, see Arena
+        long long arenaAllocs;
+        long long arenaBytes;
+
         // error handling
         ExceptionInfo exceptionInfo;
         
@@ -228,6 +247,46 @@ namespace mongo {
         void yielded() { _numYields++; }
         int numYields() const { return _numYields; }
         void suppressFromCurop() { _suppressFromCurop = true; }
+
+        /**
+         * Set only by the op's own thread, and read by the sampler without a lock, like _ns.
+         * Setting it is a plain store, so it's fine in loops over documents.
+         */
+        OpStage stage() const { return _stage; }
+        void setStage( OpStage stage ) { _stage = stage; }
+
+        /**
+         * Sets the stage of an op, if there is one, for the life of the scope.
+         *
+         * Scopes for the wait stages (isWaitStage) also add the time they take to the op's
+         * waitMicros.  A wait inside another wait is taken out of the outer one's time, so the
+         * waits of an op don't overlap.
+         */
+        class StageScope : boost::noncopyable {
+        public:
+            StageScope( CurOp* op , OpStage stage ) : _op( op ) { _enter( stage ); }
+            /** for the current client's op */
+            explicit StageScope( OpStage stage );
+            ~StageScope();
+        private:
+            void _enter( OpStage stage );
+            CurOp* _op;
+            OpStage _stage;
+            OpStage _prev;
+            unsigned long long _start;
+        };
+
+        /** page faults, record writes, journal waits and yields.  lock waits are in lockStat() */
+        static bool isWaitStage( OpStage stage ) {
+            return stage == OpStagePageFault || stage == OpStageWrite ||
+                   stage == OpStageJournalWait || stage == OpStageYield;
+        }
+
+        long long waitMicros( OpStage stage ) const { return _waitMicros[stage]; }
+
+        /** { pageFault : micros , write : micros , ... } for the waits that took any time */
+        BSONObj waitReport() const;
+        void waitReport( StringBuilder& builder ) const;
         
         long long getExpectedLatencyMs() const { return _expectedLatencyMs; }
         void setExpectedLatencyMs( long long latency ) { _expectedLatencyMs = latency; }
@@ -261,6 +320,8 @@ namespace mongo {
         ProgressMeter _progressMeter;
         AtomicInt32 _killPending;
         int _numYields;
+        OpStage _stage;
+        long long _waitMicros[OpStageCount];
         LockStat _lockStat;
         // _notifyList is protected by the global killCurrentOp's mtx.
         std::vector<bool*> _notifyList;
@@ -22,6 +22,7 @@
 #include "../util/concurrency/threadlocal.h"
 #include "../util/concurrency/rwlock.h"
 #include "../util/concurrency/mapsf.h"
+#include "../util/concurrency/priority_ticketholder.h"
 #include "../util/assert_util.h"
 #include "../util/stacktrace.h"
 #include "client.h"
@@ -261,10 +262,101 @@ namespace mongo {
         return DB_LEVEL_LOCKING_ENABLED;
     }
 
+    static const char* const queueClassNames[] = { "replApply", "userWrite", "userRead", "background" };
+
+    /** see Lock::QueueClass */
+    class LockScheduler : boost::noncopyable {
+    public:
+        LockScheduler() : _tickets( Unlimited , Lock::NumQueueClasses ), _on( false ) {
+            _tickets.setWeight( Lock::ReplApply , 8 );
+            _tickets.setWeight( Lock::UserWrite , 4 );
+            _tickets.setWeight( Lock::UserRead , 4 );
+            _tickets.setWeight( Lock::Background , 1 );
+            _tickets.setMaxQueueMillis( 1000 );
+        }
+
+        bool on() const { return _on; }
+
+        /** @return micros spent queued */
+        long long acquire( Lock::QueueClass c ) { return _tickets.waitForTicket( c ); }
+        void release() { _tickets.release(); }
+
+        bool configure( const BSONObj& config , string& errmsg );
+
+        void append( BSONObjBuilder& b ) const {
+            b.appendBool( "on" , _on );
+            _tickets.append( b , queueClassNames );
+        }
+
+    private:
+        // while off, tickets that are still out come back here, and anything still queued
+        // from before is let through
+        enum { Unlimited = 1 << 30 };
+
+        PriorityTicketHolder _tickets;
+        volatile bool _on;
+    };
+
+    bool LockScheduler::configure( const BSONObj& config , string& errmsg ) {
+        BSONElement tickets = config["tickets"];
+        if ( ! tickets.eoo() && ( ! tickets.isNumber() || tickets.numberInt() < 0 ) ) {
+            errmsg = "lockScheduler tickets must be a number >= 0";
+            return false;
+        }
+        BSONElement maxQueue = config["maxQueueMillis"];
+        if ( ! maxQueue.eoo() && ( ! maxQueue.isNumber() || maxQueue.numberInt() < 0 ) ) {
+            errmsg = "lockScheduler maxQueueMillis must be a number >= 0";
+            return false;
+        }
+        int weights[Lock::NumQueueClasses] = { 0 };
+        BSONObjIterator i( config["weights"].isABSONObj() ? config["weights"].Obj() : BSONObj() );
+        while ( i.more() ) {
+            BSONElement e = i.next();
+            int c = 0;
+            while ( c < Lock::NumQueueClasses && ! str::equals( e.fieldName() , queueClassNames[c] ) )
+                c++;
+            if ( c == Lock::NumQueueClasses || ! e.isNumber() || e.numberInt() <= 0 ) {
+                errmsg = str::stream() << "bad lockScheduler weight " << e;
+                return false;
+            }
+            weights[c] = e.numberInt();
+        }
+
+        for ( int c = 0; c < Lock::NumQueueClasses; c++ ) {
+            if ( weights[c] )
+                _tickets.setWeight( c , weights[c] );
+        }
+        if ( ! maxQueue.eoo() )
+            _tickets.setMaxQueueMillis( maxQueue.numberInt() );
+        if ( ! tickets.eoo() ) {
+            int n = tickets.numberInt();
+            _on = n > 0;
+            _tickets.resize( n > 0 ? n : static_cast<int>( Unlimited ) );
+        }
+        log() << "lockScheduler " << config << endl;
+        return true;
+    }
+
+    static LockScheduler& lockScheduler = *new LockScheduler();
+
+    void Lock::scheduleThreadAs( QueueClass c ) {
+        lockState().setQueueClass( c );
+    }
+
+    bool Lock::configureScheduler( const BSONObj& config , string& errmsg ) {
+        return lockScheduler.configure( config , errmsg );
+    }
+
     RWLockRecursive &Lock::ParallelBatchWriterMode::_batchLock = *(new RWLockRecursive("special"));
     void Lock::ParallelBatchWriterMode::iAmABatchParticipant() {
         lockState()._batchWriter = true;
     }
+    Lock::ParallelBatchWriterMode::Participant::Participant() : _was(lockState()._batchWriter) {
+        lockState()._batchWriter = true;
+    }
+    Lock::ParallelBatchWriterMode::Participant::~Participant() {
+        lockState()._batchWriter = _was;
+    }
 
     Lock::ParallelBatchWriterSupport::ParallelBatchWriterSupport() {
         relock();
@@ -284,15 +376,37 @@ namespace mongo {
 
 
     Lock::ScopedLock::ScopedLock( char type ) 
-        : _type(type), _stat(0) {
+        : _type(type), _stat(0), _ticket(false) {
         LockState& ls = lockState();
         ls.enterScopedLock( this );
+        if ( ls.recursiveCount() == 1 )
+            _takeTicket( ls );
     }
     Lock::ScopedLock::~ScopedLock() { 
         LockState& ls = lockState();
         int prevCount = ls.recursiveCount();
         Lock::ScopedLock* what = ls.leaveScopedLock();
         fassert( 16171 , prevCount != 1 || what == this );
+        _releaseTicket();
+    }
+
+    void Lock::ScopedLock::_takeTicket( LockState& ls ) {
+        int c = ls.queueClass();
+        if ( c == Lock::Unscheduled || ls._batchWriter || ! lockScheduler.on() )
+            return;
+        if ( c == Lock::User )
+            c = ( _type == 'r' || _type == 'R' ) ? Lock::UserRead : Lock::UserWrite;
+
+        CurOp::StageScope queued( cc().curop() , OpStageLockWait );
+        lockScheduler.acquire( static_cast<Lock::QueueClass>( c ) );
+        _ticket = true;
+    }
+
+    void Lock::ScopedLock::_releaseTicket() {
+        if ( _ticket ) {
+            _ticket = false;
+            lockScheduler.release();
+        }
     }
     
     long long Lock::ScopedLock::acquireFinished( LockStat* stat ) {
@@ -307,6 +421,7 @@ namespace mongo {
         long long micros = _timer.micros();
         _tempRelease();
         _pbws_lk.tempRelease();
+        _releaseTicket();
         _recordTime( micros ); // might as well do after we unlock
     }
 
@@ -326,6 +441,7 @@ namespace mongo {
     
     void Lock::ScopedLock::relock() {
         _pbws_lk.relock();
+        _takeTicket( lockState() );
         _relock();
         resetTime();
     }
@@ -844,6 +960,20 @@ namespace mongo {
         
     } globalLockServerStatusSection;
 
+    class LockSchedulerServerStatusSection : public ServerStatusSection {
+    public:
+        LockSchedulerServerStatusSection() : ServerStatusSection( "lockScheduler" ){}
+        virtual bool includeByDefault() const { return true; }
+        virtual bool adminOnly() const { return false; }
+
+        BSONObj generateSection( const BSONElement& configElement, bool userIsAdmin ) const {
+            BSONObjBuilder b;
+            lockScheduler.append( b );
+            return b.obj();
+        }
+
+    } lockSchedulerServerStatusSection;
+
     class LockStatsServerStatusSection : public ServerStatusSection {
     public:
         LockStatsServerStatusSection() : ServerStatusSection( "locks" ){}
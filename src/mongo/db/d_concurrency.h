@@ -53,6 +53,27 @@ namespace mongo {
         static LockStat* globalLockStat();
         static LockStat* nestableLockStat( Nestable db );
 
+        /**
+         * The queues of the lock scheduler.  When it is on (see configureScheduler), a thread's
+         * top level lock requests first wait for a ticket in its class's queue.  Tickets are
+         * given back on unlock and on temprelease, so a yielding op queues again.
+         *
+         * Threads are unscheduled unless they say otherwise with scheduleThreadAs().  User is
+         * UserRead or UserWrite by the type of each lock.  Batch writer participants are never
+         * scheduled, as everything else is stopped while they run.
+         */
+        enum QueueClass { Unscheduled = -1,
+                          ReplApply = 0, UserWrite, UserRead, Background, NumQueueClasses,
+                          User };
+        static void scheduleThreadAs( QueueClass c );
+
+        /**
+         * { tickets : n , maxQueueMillis : n , weights : { replApply : n , userWrite : n ,
+         *                                                  userRead : n , background : n } }
+         * or any part of it.  tickets : 0 turns the scheduler off, which is the default.
+         */
+        static bool configureScheduler( const BSONObj& config , string& errmsg );
+
         class ScopedLock;
 
         // note: avoid TempRelease when possible. not a good thing.
@@ -74,6 +95,14 @@ namespace mongo {
             ParallelBatchWriterMode() : _lk(_batchLock) {}
             static void iAmABatchParticipant();
             static RWLockRecursive &_batchLock;
+
+            /** a batch participant for its scope only, for threads shared with other work */
+            class Participant : boost::noncopyable {
+                const bool _was;
+            public:
+                Participant();
+                ~Participant();
+            };
         };
 
     private:
@@ -110,6 +139,9 @@ namespace mongo {
             void tempRelease(); // TempRelease class calls these
             void relock();
 
+            void _takeTicket( LockState& ls );
+            void _releaseTicket();
+
         protected:
             virtual void _tempRelease() = 0;
             virtual void _relock() = 0;
@@ -121,6 +153,7 @@ namespace mongo {
             Timer _timer;
             char _type;      // 'r','w','R','W'
             LockStat* _stat; // the stat for the relevant lock to increment when we're done
+            bool _ticket;    // from the lock scheduler
         };
 
         // note that for these classes recursive locking is ok if the recursive locking "makes sense"
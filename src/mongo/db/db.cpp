@@ -46,6 +46,7 @@
 #include "mongo/db/repl/rs.h"
 #include "mongo/db/restapi.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/op_sampler.h"
 #include "mongo/db/stats/snapshots.h"
 #include "mongo/db/ttl.h"
 #include "mongo/s/d_writeback.h"
@@ -179,6 +180,7 @@ namespace mongo {
     public:
         virtual void connected( AbstractMessagingPort* p ) {
             Client& c = Client::initThread("conn", p);
+            Lock::scheduleThreadAs( Lock::User );
             if( p->remote().isLocalHost() )
                 c.getAuthenticationInfo()->setIsALocalHostConnectionWithSpecialAuthPowers();
         }
@@ -638,6 +640,7 @@ namespace mongo {
         indexRebuilder.go();
 
         snapshotThread.go();
+        opSampler.go();
         d.clientCursorMonitor.go();
         PeriodicTask::theRunner->go();
         if (missingRepl) {
@@ -30,6 +30,7 @@ namespace mongo {
 
     struct dbtemprelease {
         Client::Context * _context;
+        scoped_ptr<CurOp::StageScope> yielding;
         scoped_ptr<Lock::TempRelease> tr;
         dbtemprelease() {
             const Client& c = cc();
@@ -42,12 +43,14 @@ namespace mongo {
             if ( _context ) {
                 _context->unlocked();
             }
+            yielding.reset(new CurOp::StageScope(c.curop(), OpStageYield));
             tr.reset(new Lock::TempRelease);
             verify( c.curop() );
             c.curop()->yielded();
         }
         ~dbtemprelease() {
             tr.reset();
+            yielding.reset();
             if ( _context ) 
                 _context->relocked();
         }
@@ -60,6 +63,7 @@ namespace mongo {
     struct dbtempreleasewritelock {
         Client::Context * _context;
         int _locktype;
+        scoped_ptr<CurOp::StageScope> yielding;
         scoped_ptr<Lock::TempRelease> tr;
         dbtempreleasewritelock() {
             const Client& c = cc();
@@ -69,12 +73,14 @@ namespace mongo {
                 return;
             if ( _context ) 
                 _context->unlocked();
+            yielding.reset(new CurOp::StageScope(c.curop(), OpStageYield));
             tr.reset(new Lock::TempRelease);
             verify( c.curop() );
             c.curop()->yielded();            
         }
         ~dbtempreleasewritelock() {
             tr.reset();
+            yielding.reset();
             if ( _context ) 
                 _context->relocked();
         }
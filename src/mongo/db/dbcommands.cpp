@@ -45,6 +45,7 @@
 #include "mongo/db/repl_block.h"
 #include "mongo/db/replutil.h"
 #include "mongo/db/security.h"
+#include "mongo/db/working_set.h"
 #include "mongo/s/d_writeback.h"
 #include "mongo/scripting/engine.h"
 #include "mongo/server.h"
@@ -65,6 +66,13 @@ namespace mongo {
             dur::setAgeOutJournalFiles(r);
             return true;
         }
+        if( cmdObj.hasElement( "lockScheduler" ) ) {
+            BSONElement e = cmdObj["lockScheduler"];
+            uassert( 16497 , "lockScheduler must be an object" , e.isABSONObj() );
+            string err;
+            uassert( 16498 , err , Lock::configureScheduler( e.Obj() , err ) );
+            return true;
+        }
         if( cmdObj.hasElement( "replIndexPrefetch" ) ) {
             if (!theReplSet) {
                 errmsg = "replication is not enabled";
@@ -1115,7 +1123,9 @@ namespace mongo {
         virtual LockType locktype() const { return READ; }
         virtual void help( stringstream &help ) const {
             help << "{ collStats:\"blog.posts\" , scale : 1 } scale divides sizes e.g. for KB use 1024\n"
-                    "    avgObjSize - in bytes";
+                    "    avgObjSize - in bytes\n"
+                    "    workingSet - true or a window in seconds, to estimate how much of the collection\n"
+                    "                 and its indexes is in the working set, see workingSetStats";
         }
         bool run(const string& dbname, BSONObj& jsobj, int, string& errmsg, BSONObjBuilder& result, bool fromRepl ) {
             string ns = dbname + "." + jsobj.firstElement().valuestr();
@@ -1173,6 +1183,15 @@ namespace mongo {
             if ( verbose )
                 result.appendArray( "extents" , extents.arr() );
 
+            BSONElement workingSet = jsobj["workingSet"];
+            if ( workingSet.trueValue() ) {
+                WorkingSetEstimator estimator( workingSet.isNumber() ? workingSet.numberInt() : 0 );
+                BSONObjBuilder ws( result.subobjStart( "workingSet" ) );
+                estimator.appendInfo( ws );
+                estimator.appendCollection( nsd , scale , ws );
+                ws.done();
+            }
+
             return true;
         }
     } cmdCollectionStats;
@@ -1306,6 +1325,86 @@ namespace mongo {
         }
     } cmdDBStats;
 
+    namespace {
+        bool moreTouched( const pair<long long,BSONObj>& a , const pair<long long,BSONObj>& b ) {
+            return a.first > b.first;
+        }
+    }
+
+    class WorkingSetStats : public Command {
+    public:
+        WorkingSetStats() : Command( "workingSetStats" ) {}
+        virtual bool slaveOk() const { return true; }
+        virtual LockType locktype() const { return READ; }
+        virtual void help( stringstream &help ) const {
+            help <<
+                "Estimate how much of each collection in a database, and of each of its indexes, is in the\n"
+                "working set, most touched first. touchedSize is what was accessed within about windowSecs,\n"
+                "residentSize is what the OS has in RAM. Not instantaneous, as it looks at every extent.\n"
+                "Example: { workingSetStats:1, windowSecs:300, samplesPerExtent:256, scale:1 }";
+        }
+        bool run(const string& dbname, BSONObj& jsobj, int, string& errmsg, BSONObjBuilder& result, bool fromRepl ) {
+            int scale = 1;
+            if ( jsobj["scale"].isNumber() ) {
+                scale = jsobj["scale"].numberInt();
+                if ( scale <= 0 ) {
+                    errmsg = "scale has to be > 0";
+                    return false;
+                }
+            }
+            else if ( jsobj["scale"].trueValue() ) {
+                errmsg = "scale has to be a number > 0";
+                return false;
+            }
+
+            int samplesPerExtent = WorkingSetEstimator::DefaultSamplesPerExtent;
+            if ( jsobj["samplesPerExtent"].isNumber() ) {
+                samplesPerExtent = jsobj["samplesPerExtent"].numberInt();
+                if ( samplesPerExtent <= 0 ) {
+                    errmsg = "samplesPerExtent has to be > 0";
+                    return false;
+                }
+            }
+
+            list<string> collections;
+            Database* d = cc().database();
+            if ( d )
+                d->namespaceIndex.getNamespaces( collections );
+
+            WorkingSetEstimator estimator( jsobj["windowSecs"].numberInt() , samplesPerExtent );
+
+            WorkingSetEstimator::Sizes total;
+            vector< pair<long long,BSONObj> > byTouched;
+            for ( list<string>::const_iterator it = collections.begin(); it != collections.end(); ++it ) {
+                NamespaceDetails* nsd = nsdetails( it->c_str() );
+                if ( ! nsd )
+                    continue;
+
+                BSONObjBuilder b;
+                b.append( "ns" , *it );
+                WorkingSetEstimator::Sizes sizes = estimator.appendCollection( nsd , scale , b );
+                BSONObjBuilder withIndexes( b.subobjStart( "total" ) );
+                sizes.appendTo( withIndexes , scale );
+                withIndexes.done();
+
+                total.add( sizes );
+                byTouched.push_back( make_pair( sizes.touched , b.obj() ) );
+            }
+            std::stable_sort( byTouched.begin() , byTouched.end() , moreTouched );
+
+            result.append( "db" , dbname );
+            estimator.appendInfo( result );
+            total.appendTo( result , scale );
+
+            BSONArrayBuilder arr( result.subarrayStart( "collections" ) );
+            for ( unsigned i = 0; i < byTouched.size(); i++ )
+                arr.append( byTouched[i].second );
+            arr.done();
+
+            return true;
+        }
+    } cmdWorkingSetStats;
+
     /* convertToCapped seems to use this */
     class CmdCloneCollectionAsCapped : public Command {
     public:
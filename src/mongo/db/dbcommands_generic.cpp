@@ -195,6 +195,7 @@ namespace mongo {
             help << "{ setParameter:1, <param>:<value> }\n";
             help << "supported so far:\n";
             help << "  journalCommitInterval\n";
+            help << "  lockScheduler\n";
             help << "  logLevel\n";
             help << "  notablescan\n";
             help << "  quiet\n";
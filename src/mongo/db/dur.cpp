@@ -61,6 +61,7 @@
 
 #include "cmdline.h"
 #include "client.h"
+#include "curop.h"
 #include "dur.h"
 #include "dur_journal.h"
 #include "dur_commitjob.h"
@@ -203,12 +204,14 @@ namespace mongo {
         }
 
         bool DurableImpl::commitNow() {
+            CurOp::StageScope waiting( OpStageJournalWait );
             stats.curr->_earlyCommits++;
             groupCommit(0);
             return true;
         }
 
         bool DurableImpl::awaitCommit() {
+            CurOp::StageScope waiting( OpStageJournalWait );
             commitJob._notify.awaitBeyondNow();
             return true;
         }
@@ -0,0 +1,306 @@
+// fts_index.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pch.h"
+
+#include <cmath>
+
+#include "mongo/db/btreecursor.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/curop-inl.h"
+#include "mongo/db/fts/fts_tokenizer.h"
+#include "mongo/db/index.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/kill_current_op.h"
+#include "mongo/db/matcher.h"
+#include "mongo/db/namespace-inl.h"
+#include "mongo/db/pdfile.h"
+#include "mongo/util/timer.h"
+
+/**
+ * Provides the text index type and the command "text".
+ *
+ * An index created as { title : "text" , body : "text" } is stored with the key pattern
+ * { _fts : "text" , _ftsx : 1 } and the indexed fields moved to "weights", e.g.
+ * { title : 1 , body : 1 }.  Extra or heavier fields can be given there directly:
+ * > db.foo.ensureIndex({ body : "text" }, { weights : { title : 10 } })
+ *
+ * Each document gets one key { "" : term , "" : score } per distinct term of its indexed
+ * fields, so the btree holds the postings of each term together.  The score of a term is
+ * the sum, over the fields it appears in, of the field's weight times the term's augmented
+ * frequency in that field, 0.5 + 0.5 * count / (count of the field's most frequent term).
+ *
+ * The text command looks up each term of the search string, weighs the postings of a term
+ * by its inverse document frequency, and returns the documents with the highest total:
+ * > db.runCommand({ text : "foo" , search : "fast btree" , filter : { lang : "en" } })
+ */
+namespace mongo {
+
+    static const string TEXT_INDEX_NAME = "text";
+
+    class FTSIndexType : public IndexType {
+    public:
+        FTSIndexType(const IndexPlugin* plugin, const IndexSpec* spec)
+            : IndexType(plugin, spec) {
+            BSONForEach(e, spec->info["weights"].embeddedObjectUserCheck()) {
+                _weights.push_back(make_pair(string(e.fieldName()), e.numberDouble()));
+            }
+            uassert(16485, "text index has no weighted fields, spec=" + spec->info.toString(),
+                    !_weights.empty());
+        }
+
+        virtual ~FTSIndexType() { }
+
+        void getKeys(const BSONObj& obj, BSONObjSet& keys) const {
+            map<string, double> scores;
+
+            for (unsigned i = 0; i < _weights.size(); i++) {
+                BSONElementMSet values;
+                obj.getFieldsDotted(_weights[i].first, values);
+
+                map<string, unsigned> counts;
+                for (BSONElementMSet::const_iterator v = values.begin(); v != values.end(); ++v) {
+                    if (v->type() == String)
+                        TextTokenizer::countTerms(v->String(), &counts);
+                }
+
+                typedef map<string, unsigned>::const_iterator CountIt;
+                unsigned maxCount = 0;
+                for (CountIt c = counts.begin(); c != counts.end(); ++c)
+                    maxCount = std::max(maxCount, c->second);
+
+                for (CountIt c = counts.begin(); c != counts.end(); ++c) {
+                    scores[c->first] += _weights[i].second *
+                                        (0.5 + 0.5 * c->second / maxCount);
+                }
+            }
+
+            for (map<string, double>::const_iterator s = scores.begin(); s != scores.end(); ++s) {
+                BSONObjBuilder b;
+                b.append("", s->first);
+                b.append("", s->second);
+                keys.insert(b.obj());
+            }
+        }
+
+        /** a text index only answers the text command, never an ordinary query */
+        IndexSuitability suitability(const BSONObj& query, const BSONObj& order) const {
+            return USELESS;
+        }
+
+        shared_ptr<Cursor> newCursor(const BSONObj& query, const BSONObj& order,
+                                     int numWanted) const {
+            uasserted(16486, "text indexes can only be searched with the text command");
+            return shared_ptr<Cursor>();
+        }
+
+        void searchCommand(NamespaceDetails* nsd, const string& search, const BSONObj& filter,
+                           unsigned limit, BSONObjBuilder& result) const {
+            Timer t;
+
+            LOG(1) << "TEXT search: " << search << " filter: " << filter << endl;
+
+            map<string, unsigned> terms;
+            TextTokenizer::countTerms(search, &terms);
+
+            // Total score of every document holding at least one of the terms
+            map<DiskLoc, double> scores;
+            double nrecords = std::max<long long>(1, nsd->stats.nrecords);
+            long long nscanned = 0;
+
+            vector< pair<DiskLoc, double> > postings;
+            for (map<string, unsigned>::const_iterator i = terms.begin(); i != terms.end(); ++i) {
+                BSONObjBuilder start;
+                start.append("", i->first);
+                start.appendMinKey("");
+                BSONObjBuilder end;
+                end.append("", i->first);
+                end.appendMaxKey("");
+
+                postings.clear();
+                scoped_ptr<BtreeCursor> cursor(BtreeCursor::make(nsd, *getDetails(),
+                                                                 start.obj(), end.obj(),
+                                                                 true, 1));
+                while (cursor->ok()) {
+                    BSONObjIterator key(cursor->currKey());
+                    key.next();
+                    postings.push_back(make_pair(cursor->currLoc(), key.next().numberDouble()));
+                    cursor->advance();
+                    nscanned++;
+                }
+                killCurrentOp.checkForInterrupt();
+
+                // rarer terms say more about a document
+                double idf = std::log(1 + nrecords / std::max<size_t>(1, postings.size()));
+                for (unsigned j = 0; j < postings.size(); j++)
+                    scores[postings[j].first] += postings[j].second * idf;
+            }
+
+            vector< pair<double, DiskLoc> > ranked;
+            ranked.reserve(scores.size());
+            for (map<DiskLoc, double>::const_iterator i = scores.begin(); i != scores.end(); ++i)
+                ranked.push_back(make_pair(-i->second, i->first));
+            std::sort(ranked.begin(), ranked.end());
+
+            scoped_ptr<Matcher> matcher;
+            if (!filter.isEmpty())
+                matcher.reset(new Matcher(filter));
+
+            long long nscannedObjects = 0;
+            int n = 0;
+            BSONArrayBuilder arr(result.subarrayStart("results"));
+            for (unsigned i = 0; i < ranked.size() && static_cast<unsigned>(n) < limit; i++) {
+                BSONObj obj = ranked[i].second.obj();
+                nscannedObjects++;
+                if (matcher && !matcher->matches(obj))
+                    continue;
+                // leave room in the reply for the stats
+                if (arr.len() + obj.objsize() + 1024 > BSONObjMaxUserSize)
+                    break;
+
+                BSONObjBuilder b(arr.subobjStart());
+                b.append("score", -ranked[i].first);
+                b.append("obj", obj);
+                b.done();
+                n++;
+            }
+            arr.done();
+
+            {
+                BSONObjBuilder b(result.subobjStart("stats"));
+                b.appendNumber("nscanned", nscanned);
+                b.appendNumber("nscannedObjects", nscannedObjects);
+                b.appendNumber("nfound", static_cast<long long>(scores.size()));
+                b.append("n", n);
+                b.append("timeMicros", static_cast<long long>(t.micros()));
+                b.done();
+            }
+        }
+
+        const IndexDetails* getDetails() const {
+            return _spec->getDetails();
+        }
+
+    private:
+        vector< pair<string, double> > _weights;
+    };
+
+    class FTSIndexPlugin : public IndexPlugin {
+    public:
+        FTSIndexPlugin() : IndexPlugin(TEXT_INDEX_NAME) { }
+
+        virtual IndexType* generate(const IndexSpec* spec) const {
+            return new FTSIndexType(this, spec);
+        }
+
+        /**
+         * Rewrites { key : { a : "text" , b : "text" } , weights : { c : 5 } } as
+         * { key : { _fts : "text" , _ftsx : 1 } , weights : { a : 1 , b : 1 , c : 5 } }.
+         */
+        virtual BSONObj adjustIndexSpec(const BSONObj& spec) const {
+            uassert(16484, "text indexes cannot be unique", !spec["unique"].trueValue());
+
+            BSONObj key = spec["key"].Obj();
+            if (key.hasField("_fts"))
+                return spec;
+
+            BSONObj explicitWeights;
+            if (spec["weights"].isABSONObj())
+                explicitWeights = spec["weights"].Obj();
+
+            BSONObjBuilder weights;
+            BSONForEach(e, key) {
+                uassert(16487, str::stream() << "text index keys may only name text fields: "
+                                             << key,
+                        e.type() == String && TEXT_INDEX_NAME == e.valuestr());
+                if (!explicitWeights.hasField(e.fieldName()))
+                    weights.append(e.fieldName(), 1);
+            }
+            BSONForEach(e, explicitWeights) {
+                uassert(16488, str::stream() << "text index weights must be positive numbers: "
+                                             << explicitWeights,
+                        e.isNumber() && e.numberDouble() > 0);
+                weights.append(e);
+            }
+
+            BSONObjBuilder b;
+            BSONForEach(e, spec) {
+                string field = e.fieldName();
+                if (field != "key" && field != "weights")
+                    b.append(e);
+            }
+            b.append("key", BSON("_fts" << TEXT_INDEX_NAME << "_ftsx" << 1));
+            b.append("weights", weights.obj());
+            return b.obj();
+        }
+    } ftsIndexPlugin;
+
+    class TextSearchCommand : public Command {
+    public:
+        TextSearchCommand() : Command("text") {}
+
+        virtual LockType locktype() const { return READ; }
+        bool slaveOk() const { return true; }
+        bool slaveOverrideOk() const { return true; }
+
+        void help(stringstream& h) const {
+            h << "search a collection's text index, best matches first\n"
+              << "{ text : <collection> , search : <string> , filter : <query> , limit : <n> }";
+        }
+
+        bool run(const string& dbname, BSONObj& cmdObj, int,
+                 string& errmsg, BSONObjBuilder& result, bool fromRepl) {
+            string ns = dbname + "." + cmdObj.firstElement().valuestr();
+
+            NamespaceDetails *nsd = nsdetails(ns.c_str());
+            if (NULL == nsd) {
+                errmsg = "can't find ns";
+                return false;
+            }
+
+            vector<int> idxs;
+            nsd->findIndexByType(TEXT_INDEX_NAME, idxs);
+            if (idxs.size() == 0) {
+                errmsg = "no text index";
+                return false;
+            }
+            if (idxs.size() > 1) {
+                errmsg = "more than 1 text index";
+                return false;
+            }
+
+            IndexDetails& id = nsd->idx(idxs[0]);
+            FTSIndexType *fts = static_cast<FTSIndexType*>(id.getSpec().getType());
+            verify(&id == fts->getDetails());
+
+            BSONElement search = cmdObj["search"];
+            uassert(16489, "search needs to be a string", search.type() == String);
+
+            BSONObj filter;
+            if (cmdObj["filter"].isABSONObj())
+                filter = cmdObj["filter"].Obj();
+
+            unsigned limit = 100;
+            if (cmdObj["limit"].isNumber())
+                limit = static_cast<unsigned>(cmdObj["limit"].numberInt());
+
+            fts->searchCommand(nsd, search.String(), filter, limit, result);
+            return true;
+        }
+    } textSearchCommand;
+}
@@ -0,0 +1,205 @@
+// fts_tokenizer.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/db/fts/fts_tokenizer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mongo {
+
+    namespace {
+
+        // sorted, for binary_search
+        const char* const stopWords[] = {
+            "a", "about", "after", "all", "also", "an", "and", "any", "are", "as", "at",
+            "be", "been", "but", "by", "can", "could", "did", "do", "does", "for", "from",
+            "had", "has", "have", "he", "her", "his", "how", "i", "if", "in", "into", "is",
+            "it", "its", "may", "me", "more", "my", "no", "not", "of", "on", "or", "our",
+            "she", "so", "than", "that", "the", "their", "them", "then", "there", "these",
+            "they", "this", "to", "up", "was", "we", "were", "what", "when", "which", "who",
+            "will", "with", "would", "you", "your"
+        };
+
+        bool lessCStr( const char* a , const char* b ) {
+            return strcmp( a , b ) < 0;
+        }
+
+        inline bool isWordByte( unsigned char c ) {
+            return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) ||
+                   ( c >= '0' && c <= '9' ) || c >= 0x80;
+        }
+
+        inline bool isLetter( char c ) {
+            return c >= 'a' && c <= 'z';
+        }
+
+        // Porter's definition: a, e, i, o, u, and y when it follows a consonant
+        bool isConsonant( const std::string& w , size_t i ) {
+            switch ( w[i] ) {
+            case 'a': case 'e': case 'i': case 'o': case 'u':
+                return false;
+            case 'y':
+                return i == 0 || ! isConsonant( w , i - 1 );
+            default:
+                return true;
+            }
+        }
+
+        /** the number of vowel-consonant sequences in the first 'len' letters of 'w' */
+        int measure( const std::string& w , size_t len ) {
+            int m = 0;
+            size_t i = 0;
+            while ( i < len && isConsonant( w , i ) ) i++;
+            while ( i < len ) {
+                while ( i < len && ! isConsonant( w , i ) ) i++;
+                if ( i == len ) break;
+                while ( i < len && isConsonant( w , i ) ) i++;
+                m++;
+            }
+            return m;
+        }
+
+        bool hasVowel( const std::string& w , size_t len ) {
+            for ( size_t i = 0; i < len; i++ ) {
+                if ( ! isConsonant( w , i ) )
+                    return true;
+            }
+            return false;
+        }
+
+        bool endsWith( const std::string& w , const char* suffix ) {
+            size_t n = strlen( suffix );
+            return w.size() >= n && w.compare( w.size() - n , n , suffix ) == 0;
+        }
+
+        bool endsDoubleConsonant( const std::string& w ) {
+            size_t n = w.size();
+            return n >= 2 && w[n-1] == w[n-2] && isConsonant( w , n - 1 );
+        }
+
+        /** consonant-vowel-consonant, where the last consonant isn't w, x or y, e.g. "hop" */
+        bool endsCVC( const std::string& w ) {
+            size_t n = w.size();
+            if ( n < 3 ) return false;
+            if ( ! isConsonant( w , n - 1 ) || isConsonant( w , n - 2 ) ||
+                 ! isConsonant( w , n - 3 ) )
+                return false;
+            char c = w[n-1];
+            return c != 'w' && c != 'x' && c != 'y';
+        }
+
+        void appendTerm( const std::string& word , std::vector<std::string>* terms ) {
+            if ( word.size() > TextTokenizer::MaxTermLength || TextTokenizer::isStopWord( word ) )
+                return;
+            terms->push_back( TextTokenizer::stem( word ) );
+        }
+    }
+
+    void TextTokenizer::terms( const std::string& text , std::vector<std::string>* terms ) {
+        std::string word;
+        for ( size_t i = 0; i < text.size(); i++ ) {
+            unsigned char c = text[i];
+            if ( isWordByte( c ) ) {
+                word += ( c >= 'A' && c <= 'Z' ) ? static_cast<char>( c - 'A' + 'a' )
+                                                 : static_cast<char>( c );
+                continue;
+            }
+            if ( ! word.empty() ) {
+                appendTerm( word , terms );
+                word.clear();
+            }
+        }
+        if ( ! word.empty() )
+            appendTerm( word , terms );
+    }
+
+    unsigned TextTokenizer::countTerms( const std::string& text ,
+                                        std::map<std::string,unsigned>* counts ) {
+        std::vector<std::string> all;
+        terms( text , &all );
+        for ( unsigned i = 0; i < all.size(); i++ )
+            (*counts)[ all[i] ]++;
+        return all.size();
+    }
+
+    bool TextTokenizer::isStopWord( const std::string& word ) {
+        const char* const* end = stopWords + sizeof( stopWords ) / sizeof( stopWords[0] );
+        return std::binary_search( stopWords , end , word.c_str() , lessCStr );
+    }
+
+    std::string TextTokenizer::stem( const std::string& word ) {
+        if ( word.size() <= 2 )
+            return word;
+        for ( size_t i = 0; i < word.size(); i++ ) {
+            // leave numbers and non-ASCII words alone
+            if ( ! isLetter( word[i] ) )
+                return word;
+        }
+
+        std::string w = word;
+
+        // Step 1a: plurals
+        if ( endsWith( w , "sses" ) || endsWith( w , "ies" ) )
+            w.erase( w.size() - 2 );
+        else if ( ! endsWith( w , "ss" ) && endsWith( w , "s" ) )
+            w.erase( w.size() - 1 );
+
+        // Step 1b: -eed, -ed, -ing
+        bool cleanup = false;
+        if ( endsWith( w , "eed" ) ) {
+            if ( measure( w , w.size() - 3 ) > 0 )
+                w.erase( w.size() - 1 );
+        }
+        else if ( endsWith( w , "ed" ) && hasVowel( w , w.size() - 2 ) ) {
+            w.erase( w.size() - 2 );
+            cleanup = true;
+        }
+        else if ( endsWith( w , "ing" ) && hasVowel( w , w.size() - 3 ) ) {
+            w.erase( w.size() - 3 );
+            cleanup = true;
+        }
+        if ( cleanup ) {
+            if ( endsWith( w , "at" ) || endsWith( w , "bl" ) || endsWith( w , "iz" ) ) {
+                w += 'e';
+            }
+            else if ( endsDoubleConsonant( w ) ) {
+                char c = w[ w.size() - 1 ];
+                if ( c != 'l' && c != 's' && c != 'z' )
+                    w.erase( w.size() - 1 );
+            }
+            else if ( measure( w , w.size() ) == 1 && endsCVC( w ) ) {
+                w += 'e';
+            }
+        }
+
+        // Step 1c: y -> i
+        if ( endsWith( w , "y" ) && hasVowel( w , w.size() - 1 ) )
+            w[ w.size() - 1 ] = 'i';
+
+        // Step 5a: a final e, so "indexe" (from "indexes") meets "index"
+        if ( endsWith( w , "e" ) ) {
+            int m = measure( w , w.size() - 1 );
+            if ( m > 1 || ( m == 1 && ! endsCVC( w.substr( 0 , w.size() - 1 ) ) ) )
+                w.erase( w.size() - 1 );
+        }
+
+        return w;
+    }
+
+}
@@ -0,0 +1,55 @@
+// fts_tokenizer.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mongo {
+
+    /**
+     * Turns text into the terms a text index stores and a text search looks up.
+     *
+     * A word is a run of ASCII letters and digits or of non-ASCII (UTF-8) bytes.  Words are
+     * lower cased (ASCII only), English stop words are dropped and the rest are stemmed with
+     * steps 1 and 5a of the Porter stemmer, so "Indexes", "indexed" and "indexing" all give
+     * "index".
+     * Words longer than MaxTermLength bytes are dropped rather than truncated, so they can't
+     * collide with a shorter word.
+     */
+    class TextTokenizer {
+    public:
+        static const size_t MaxTermLength = 64;
+
+        /** appends the terms of 'text' to 'terms' in order, repeats included */
+        static void terms( const std::string& text , std::vector<std::string>* terms );
+
+        /** counts the terms of 'text' into 'counts' @return the number of terms seen */
+        static unsigned countTerms( const std::string& text ,
+                                    std::map<std::string,unsigned>* counts );
+
+        /** @param word lower case */
+        static bool isStopWord( const std::string& word );
+
+        /** @param word lower case @return the stem of 'word' */
+        static std::string stem( const std::string& word );
+    };
+
+}
@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2012 10gen Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains tests for mongo/db/fts/fts_tokenizer.cpp.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/db/fts/fts_tokenizer.h"
+#include "mongo/unittest/unittest.h"
+
+using mongo::TextTokenizer;
+using std::map;
+using std::string;
+using std::vector;
+
+namespace {
+
+    TEST(TextTokenizer, SplitsAndLowerCases) {
+        vector<string> terms;
+        TextTokenizer::terms("Quick,brown  FOX-jumps 42times", &terms);
+        ASSERT_EQUALS(terms.size(), 5U);
+        ASSERT_EQUALS(terms[0], "quick");
+        ASSERT_EQUALS(terms[1], "brown");
+        ASSERT_EQUALS(terms[2], "fox");
+        ASSERT_EQUALS(terms[3], "jump");
+        ASSERT_EQUALS(terms[4], "42times");
+    }
+
+    TEST(TextTokenizer, DropsStopWords) {
+        vector<string> terms;
+        TextTokenizer::terms("The cat and the hat", &terms);
+        ASSERT_EQUALS(terms.size(), 2U);
+        ASSERT_EQUALS(terms[0], "cat");
+        ASSERT_EQUALS(terms[1], "hat");
+        ASSERT_TRUE(TextTokenizer::isStopWord("the"));
+        ASSERT_FALSE(TextTokenizer::isStopWord("cat"));
+    }
+
+    TEST(TextTokenizer, DropsLongWords) {
+        vector<string> terms;
+        TextTokenizer::terms(string(TextTokenizer::MaxTermLength + 1, 'x') + " short", &terms);
+        ASSERT_EQUALS(terms.size(), 1U);
+        ASSERT_EQUALS(terms[0], "short");
+    }
+
+    TEST(TextTokenizer, KeepsNonAsciiWords) {
+        vector<string> terms;
+        TextTokenizer::terms("caf\xc3\xa9 na\xc3\xafve", &terms);
+        ASSERT_EQUALS(terms.size(), 2U);
+        ASSERT_EQUALS(terms[0], "caf\xc3\xa9");
+        ASSERT_EQUALS(terms[1], "na\xc3\xafve");
+    }
+
+    TEST(TextTokenizer, StemsInflections) {
+        ASSERT_EQUALS(TextTokenizer::stem("indexes"), "index");
+        ASSERT_EQUALS(TextTokenizer::stem("indexed"), "index");
+        ASSERT_EQUALS(TextTokenizer::stem("indexing"), "index");
+        ASSERT_EQUALS(TextTokenizer::stem("caresses"), "caress");
+        ASSERT_EQUALS(TextTokenizer::stem("ponies"), "poni");
+        ASSERT_EQUALS(TextTokenizer::stem("pony"), "poni");
+        ASSERT_EQUALS(TextTokenizer::stem("agreed"), TextTokenizer::stem("agree"));
+        ASSERT_EQUALS(TextTokenizer::stem("hopping"), "hop");
+        ASSERT_EQUALS(TextTokenizer::stem("hoping"), "hope");
+        ASSERT_EQUALS(TextTokenizer::stem("created"), TextTokenizer::stem("create"));
+        ASSERT_EQUALS(TextTokenizer::stem("falling"), "fall");
+        ASSERT_EQUALS(TextTokenizer::stem("sing"), "sing");
+        ASSERT_EQUALS(TextTokenizer::stem("as"), "as");
+    }
+
+    TEST(TextTokenizer, CountsTerms) {
+        map<string, unsigned> counts;
+        ASSERT_EQUALS(TextTokenizer::countTerms("dogs chase dog toys", &counts), 4U);
+        ASSERT_EQUALS(counts.size(), 3U);
+        ASSERT_EQUALS(counts["dog"], 2U);
+        ASSERT_EQUALS(counts["chase"], 1U);
+        ASSERT_EQUALS(counts["toi"], 1U);
+    }
+
+}
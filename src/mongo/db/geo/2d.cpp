@@ -1413,7 +1413,9 @@ namespace mongo {
               _type(type),
               _distError(type == GEO_PLAIN ? g->getConverter().getError() 
                                            : g->getConverter().getErrorSphere()),
-              _farthest(0)
+              _farthest(0),
+              _minDistance(-1),
+              _returnedAtMin(0)
         {}
 
         virtual KeyResult approxKeyCheck(const Point& p, double& d) {
@@ -1431,6 +1433,9 @@ namespace mongo {
             }
             verify(d >= 0);
 
+            // Keys well inside _minDistance were all returned by an earlier pass
+            if (_minDistance >= 0 && d < _minDistance - 2 * _distError) return BAD;
+
             GEODEBUG("\t\t\t\t\t\t\t checkDistance " << _near.toString()
                       << "\t" << p.toString() << "\t" << d
                       << " farthest: " << farthest());
@@ -1462,6 +1467,13 @@ namespace mongo {
             return within;
         }
 
+        /** @return true if the exact point 'pt' of 'loc' at distance 'd' was returned by an earlier pass */
+        bool returnedBefore(const DiskLoc& loc, const BSONObj& pt, double d) const {
+            if (d < _minDistance) return true;
+            return d == _minDistance && _returnedAtMin &&
+                   _returnedAtMin->count(make_pair(loc, pt)) > 0;
+        }
+
         // Always in distance units, whether radians or normal
         double farthest() const {
             return _farthest;
@@ -1560,6 +1572,12 @@ namespace mongo {
         double _distError;
         double _farthest;
 
+        // Set by GeoNearCursor to resume a search after the points it has already returned:
+        // exact points nearer than _minDistance are skipped, as are those at exactly
+        // _minDistance listed in _returnedAtMin.
+        double _minDistance;
+        const set< pair<DiskLoc, BSONObj> >* _returnedAtMin;
+
         // Safe to use currently since we don't yield in $near searches.  If we do start to yield, we may need to
         // replace dirtied disklocs in our holder / ensure our logic is correct.
         map< DiskLoc, Holder::iterator > _seenPts;
@@ -1582,6 +1600,7 @@ namespace mongo {
              _start(g->getConverter().hash(startPt.x, startPt.y)),
              // TODO:  Remove numWanted...
              _numWanted(numWanted),
+             _candidates(0),
              _type(type)
         {
 
@@ -1745,6 +1764,7 @@ namespace mongo {
 
                 double d;
                 if(! exactDocCheck(loc, d)) continue;
+                if(! _uniqueDocs && returnedBefore(pt.loc(), *i, d)) continue;
 
                 if(_uniqueDocs && (nearestPt.distance() < 0 || d < nearestPt.distance())){
                     nearestPt._distance = d;
@@ -1761,7 +1781,9 @@ namespace mongo {
 
             }
 
-            if(_uniqueDocs && nearestPt.distance() >= 0){
+            // A unique doc is only returned once, at its nearest point
+            if(_uniqueDocs && nearestPt.distance() >= 0 &&
+               ! returnedBefore(pt.loc(), nearestPt.pt(), nearestPt.distance())){
                 GEODEBUG("Inserting unique exact pt " << nearestPt.toString() << " for " << pt.toString() << " exact : " << nearestPt.distance() << " is less? " << (nearestPt < pt) << " bits : " << _g->_bits);
                 points.insert(nearestPt);
                 if(nearestPt < pt) before++;
@@ -1774,6 +1796,7 @@ namespace mongo {
         void expandEndPoints(bool finish = true){
 
             processExtraPoints();
+            _candidates = _points.size();
 
             // All points in array *could* be in maxDistance
 
@@ -1911,6 +1934,9 @@ namespace mongo {
         int _numWanted;
         double _scanDistance;
 
+        // Points held before the final expansion, including any later skipped as returned before
+        long long _candidates;
+
         long long _nscanned;
         int _found;
         GeoDistType _type;
@@ -1918,61 +1944,133 @@ namespace mongo {
         Box _want;
     };
 
-    class GeoSearchCursor : public GeoCursorBase {
+    /**
+     * Streams a $near search in increasing distance order.  Rather than holding every wanted point
+     * at once, the search is run in passes of at most BatchSize points; each pass resumes from the
+     * distance of the last point returned, skipping the points already returned at that distance.
+     * Because each pass is a fresh search, the cursor can also drop its pass between getMores and
+     * pick up where it left off.
+     */
+    class GeoNearCursor : public GeoCursorBase {
     public:
-        GeoSearchCursor(shared_ptr<GeoSearch> s)
-            : GeoCursorBase(s->_spec),
-              _s(s), _cur(s->_points.begin()), _end(s->_points.end()), _nscanned() {
-            if (_cur != _end) {
+        static const int BatchSize = 1000;
+
+        GeoNearCursor(const Geo2dType * g, const Point& near, int numWanted, const BSONObj& filter,
+                      double maxDistance, GeoDistType type, bool uniqueDocs)
+            : GeoCursorBase(g), _near(near), _numWanted(numWanted), _filter(filter.getOwned()),
+              _maxDistance(maxDistance), _type(type), _uniqueDocs(uniqueDocs),
+              _batchSize(std::min(numWanted, static_cast<int>(BatchSize))),
+              _minDistance(-1), _returned(0), _needPass(false), _done(false), _nscanned() {
+            nextPass();
+            if (ok()) {
                 ++_nscanned;
             }
         }
 
-        virtual ~GeoSearchCursor() {}
+        virtual ~GeoNearCursor() {}
 
         virtual bool ok() {
-            return _cur != _end;
+            if (_needPass) nextPass();
+            return ! _done && _cur != _s->_points.end();
         }
 
         virtual Record* _current() { verify(ok()); return _cur->_loc.rec(); }
         virtual BSONObj current() { verify(ok()); return _cur->_o; }
         virtual DiskLoc currLoc() { verify(ok()); return _cur->_loc; }
         virtual bool advance() {
-            if(ok()){
-                _cur++;
-                incNscanned();
-                return ok();
+            if (! ok()) return false;
+
+            if (_cur->distance() != _minDistance) {
+                _minDistance = _cur->distance();
+                _returnedAtMin.clear();
             }
-            return false;
+            _returnedAtMin.insert(make_pair(_cur->_loc, _cur->pt().getOwned()));
+            _returned++;
+
+            _cur++;
+            if (_cur == _s->_points.end() && _returned < _numWanted) nextPass();
+            incNscanned();
+            return ok();
         }
         virtual BSONObj currKey() const { return _cur->_key; }
 
+        /** the points of the current pass may move between getMores, so search again afterward */
+        virtual void noteLocation() {
+            if (_done) return;
+            _s.reset();
+            _needPass = true;
+        }
+
+        virtual void checkLocation() {
+            if (_needPass) nextPass();
+        }
+
+        virtual bool supportGetMore() { return true; }
+
         virtual string toString() {
             return "GeoSearchCursor";
         }
 
-
         virtual BSONObj prettyStartKey() const {
-            return BSON(_s->_g->_geo << _s->_prefix.toString());
+            if (! _s) return BSONObj();
+            return BSON(_spec->_geo << _s->_prefix.toString());
         }
         virtual BSONObj prettyEndKey() const {
+            if (! _s) return BSONObj();
             GeoHash temp = _s->_prefix;
             temp.move(1, 1);
-            return BSON(_s->_g->_geo << temp.toString());
+            return BSON(_spec->_geo << temp.toString());
         }
 
         virtual long long nscanned() { return _nscanned; }
 
         virtual CoveredIndexMatcher* matcher() const {
-            if(_s->_matcher.get()) return _s->_matcher.get();
+            if(_s && _s->_matcher.get()) return _s->_matcher.get();
             else return emptyMatcher.get();
         }
 
-        shared_ptr<GeoSearch> _s;
-        GeoHopper::Holder::iterator _cur;
-        GeoHopper::Holder::iterator _end;
+    private:
+        /**
+         * Searches for the next points beyond those returned so far.  A pass can come back empty
+         * while there are still points left if all its candidates tied with points already
+         * returned, in which case we search again for a larger batch.
+         */
+        void nextPass() {
+            _needPass = false;
+            int batch = std::min(_batchSize, static_cast<int>(_numWanted - _returned));
+            while (true) {
+                _s.reset(new GeoSearch(_spec, _near, batch, _filter, _maxDistance, _type,
+                                       _uniqueDocs, true));
+                _s->_minDistance = _minDistance;
+                _s->_returnedAtMin = &_returnedAtMin;
+                _s->exec();
+                _cur = _s->_points.begin();
+
+                if (_cur != _s->_points.end() || _s->_candidates < batch) break;
+                batch *= 2;
+            }
+            _done = _cur == _s->_points.end();
+        }
 
         void incNscanned() { if (ok()) { ++_nscanned; } }
+
+        Point _near;
+        long long _numWanted;
+        BSONObj _filter;
+        double _maxDistance;
+        GeoDistType _type;
+        bool _uniqueDocs;
+        int _batchSize;
+
+        // Distance of the last point returned, and the points returned at exactly that distance
+        double _minDistance;
+        set< pair<DiskLoc, BSONObj> > _returnedAtMin;
+        long long _returned;
+
+        shared_ptr<GeoSearch> _s;
+        GeoHopper::Holder::iterator _cur;
+        bool _needPass;
+        bool _done;
         long long _nscanned;
     };
 
@@ -2306,11 +2404,9 @@ namespace mongo {
                     bool uniqueDocs = false;
                     if(! n["$uniqueDocs"].eoo()) uniqueDocs = n["$uniqueDocs"].trueValue();
 
-                    shared_ptr<GeoSearch> s(new GeoSearch(this, Point(e), numWanted, query,
-                                                          maxDistance, type, uniqueDocs));
-                    s->exec();
                     shared_ptr<Cursor> c;
-                    c.reset(new GeoSearchCursor(s));
+                    c.reset(new GeoNearCursor(this, Point(e), numWanted, query,
+                                              maxDistance, type, uniqueDocs));
                     return c;
                 }
                 case BSONObj::opWITHIN: {
@@ -93,7 +93,96 @@ namespace mongo {
         return queryBuilder.obj();
     }
 
+    BSONObj S2SearchUtil::cachedCoverAsBSON(const S2IndexingParams &params,
+                                            const S2Region &region, const string& field,
+                                            const string& regionKey) {
+        stringstream ss;
+        ss << params.coarsestIndexedLevel << ',' << params.finestIndexedLevel << ','
+           << params.maxCellsInCovering << ',' << field << ',';
+        string key = ss.str() + regionKey;
+
+        S2CoverCache& cache = S2CoverCache::get();
+        BSONObj cover;
+        if (cache.lookup(key, &cover)) { return cover; }
+
+        S2RegionCoverer coverer;
+        params.configureCoverer(&coverer);
+        cover = coverAsBSON(&coverer, region, field);
+        cache.add(key, cover);
+        return cover;
+    }
+
+    S2CoverCache::S2CoverCache(size_t maxBytes)
+        : _maxBytes(maxBytes), _mutex("S2CoverCache"), _bytes(0), _hits(0), _misses(0) { }
+
+    S2CoverCache& S2CoverCache::get() {
+        static S2CoverCache cache;
+        return cache;
+    }
+
+    bool S2CoverCache::lookup(const string& key, BSONObj* cover) {
+        SimpleMutex::scoped_lock lk(_mutex);
+        EntryMap::iterator it = _map.find(key);
+        if (_map.end() == it) {
+            ++_misses;
+            return false;
+        }
+        ++_hits;
+        _lru.splice(_lru.begin(), _lru, it->second);
+        *cover = it->second->second;
+        return true;
+    }
+
+    void S2CoverCache::add(const string& key, const BSONObj& cover) {
+        size_t sz = entryBytes(key, cover);
+        // Don't let one huge covering flush everything else.
+        if (sz > _maxBytes / 4) { return; }
+
+        SimpleMutex::scoped_lock lk(_mutex);
+        EntryMap::iterator it = _map.find(key);
+        if (_map.end() != it) { _evict(it->second); }
+        while (!_lru.empty() && _bytes + sz > _maxBytes) { _evict(--_lru.end()); }
+
+        _lru.push_front(make_pair(key, cover.getOwned()));
+        _map[key] = _lru.begin();
+        _bytes += sz;
+    }
+
+    void S2CoverCache::_evict(EntryList::iterator it) {
+        _bytes -= entryBytes(it->first, it->second);
+        _map.erase(it->first);
+        _lru.erase(it);
+    }
+
+    void S2CoverCache::clear() {
+        SimpleMutex::scoped_lock lk(_mutex);
+        _lru.clear();
+        _map.clear();
+        _bytes = 0;
+    }
+
+    size_t S2CoverCache::size() {
+        SimpleMutex::scoped_lock lk(_mutex);
+        return _lru.size();
+    }
+
+    size_t S2CoverCache::bytes() {
+        SimpleMutex::scoped_lock lk(_mutex);
+        return _bytes;
+    }
+
+    long long S2CoverCache::hits() {
+        SimpleMutex::scoped_lock lk(_mutex);
+        return _hits;
+    }
+
+    long long S2CoverCache::misses() {
+        SimpleMutex::scoped_lock lk(_mutex);
+        return _misses;
+    }
+
     bool GeoQueryField::parseFrom(BSONObj& obj) {
+        geometry = obj.getOwned();
         if (GeoJSONParser::isPolygon(obj)) {
             // We can't really pass these things around willy-nilly except by ptr.
             polygon = new S2Polygon();
@@ -22,9 +22,14 @@
 #include "third_party/s2/s2polygon.h"
 #include "third_party/s2/s2regioncoverer.h"
 
+#include "mongo/platform/unordered_map.h"
+#include "mongo/util/concurrency/mutex.h"
+
 #pragma once
 
 namespace mongo {
+    struct S2IndexingParams;
+
     // This is used by both s2cursor and s2nearcursor.
     class S2SearchUtil {
     public:
@@ -32,6 +37,55 @@ namespace mongo {
         // FieldRangeSet so that we only examine the keys that the provided region may intersect.
         static BSONObj coverAsBSON(S2RegionCoverer *coverer, const S2Region &region,
                                    const string& field);
+
+        // Same as coverAsBSON with a coverer configured from params, but looked up in and added
+        // to the S2CoverCache.  regionKey must identify the region exactly (eg the raw bytes of
+        // the query geometry); the params and field are added to it here.
+        static BSONObj cachedCoverAsBSON(const S2IndexingParams &params, const S2Region &region,
+                                         const string& field, const string& regionKey);
+    };
+
+    // Computing a covering is the expensive part of setting up an s2 query, and the same
+    // polygons (and, for $near, the same annuli around the same points) tend to be queried over
+    // and over.  This keeps the most recently used coverAsBSON results, bounded by total size.
+    // Shared by all connections.
+    class S2CoverCache {
+    public:
+        static const size_t DefaultMaxBytes = 16 * 1024 * 1024;
+
+        S2CoverCache(size_t maxBytes = DefaultMaxBytes);
+
+        // The cache used by the s2 cursors.
+        static S2CoverCache& get();
+
+        // If key is present, sets *cover to its value, makes it the most recently used and
+        // returns true.
+        bool lookup(const string& key, BSONObj* cover);
+        // Adds (or replaces) key, evicting the least recently used entries to stay in bounds.
+        void add(const string& key, const BSONObj& cover);
+        void clear();
+
+        size_t size();
+        size_t bytes();
+        long long hits();
+        long long misses();
+
+    private:
+        typedef list<pair<string, BSONObj> > EntryList;
+        typedef unordered_map<string, EntryList::iterator> EntryMap;
+
+        static size_t entryBytes(const string& key, const BSONObj& cover) {
+            return key.size() + cover.objsize();
+        }
+        void _evict(EntryList::iterator it);
+
+        const size_t _maxBytes;
+        SimpleMutex _mutex;
+        EntryList _lru;  // Most recently used first.
+        EntryMap _map;
+        size_t _bytes;
+        long long _hits;
+        long long _misses;
     };
 
     // Used for passing geo data from the newCursor entry point to the S2Cursor class.
@@ -40,6 +94,8 @@ namespace mongo {
 
         // Name of the field in the query.
         string field;
+        // The $geometry the region was parsed from, owned.  Identifies the region for caching.
+        BSONObj geometry;
         // Only one of these should be non-NULL.  S2Region is a superclass but it only supports
         // testing against S2Cells.  We need the most specific class we can get.
         // Owned by S2Cursor.
@@ -74,12 +74,11 @@ namespace mongo {
         BSONObjBuilder frsObjBuilder;
         frsObjBuilder.appendElements(_filteredQuery);
 
-        S2RegionCoverer coverer;
-
         for (size_t i = 0; i < _fields.size(); ++i) {
-            _params.configureCoverer(&coverer);
-            BSONObj fieldRange = S2SearchUtil::coverAsBSON(&coverer, _fields[i].getRegion(),
-                                                           _fields[i].field);
+            const BSONObj &geometry = _fields[i].geometry;
+            BSONObj fieldRange = S2SearchUtil::cachedCoverAsBSON(
+                _params, _fields[i].getRegion(), _fields[i].field,
+                string(geometry.objdata(), geometry.objsize()));
             frsObjBuilder.appendElements(fieldRange);
         }
         return frsObjBuilder.obj();
@@ -123,8 +123,6 @@ namespace mongo {
         BSONObjBuilder frsObjBuilder;
         frsObjBuilder.appendElements(_filteredQuery);
 
-        S2RegionCoverer coverer;
-        _params.configureCoverer(&coverer);
         // Step 1: Make the monstrous BSONObj that describes what keys we want.
         for (size_t i = 0; i < _fields.size(); ++i) {
             const GeoQueryField &field = _fields[i];
@@ -140,7 +138,13 @@ namespace mongo {
             regions.push_back(&invInnerCap);
             regions.push_back(&outerCap);
             S2RegionIntersection shell(&regions);
-            inExpr = S2SearchUtil::coverAsBSON(&coverer, shell, field.field);
+            // The annuli for a given center are the same from one query to the next (the radius
+            // increment only depends on the params and on which shells were empty), so they
+            // cache as well as fixed geometries do.
+            BSONObj shellKey = BSON("g" << field.geometry << "i" << _innerRadius
+                                        << "o" << _outerRadius);
+            inExpr = S2SearchUtil::cachedCoverAsBSON(_params, shell, field.field,
+                                                     string(shellKey.objdata(), shellKey.objsize()));
             // Shell takes ownership of the regions we push in, but they're local variables and
             // deleting them would be bad.
             shell.Release(NULL);
@@ -29,9 +29,14 @@ namespace mongo {
     HashedIndexType::HashedIndexType( const IndexPlugin* plugin , const IndexSpec* spec ) :
             IndexType( plugin , spec ) , _keyPattern( spec->keyPattern ) {
 
-        //change these if single-field limitation lifted later
-        uassert( 16241 , "Currently only single field hashed index supported." ,
-                _keyPattern.toBSON().nFields() == 1 );
+        //change this if the single hashed field limitation is lifted later
+        int hashedFields = 0;
+        BSONForEach( e , spec->keyPattern ) {
+            if ( e.type() == String )
+                hashedFields++;
+        }
+        uassert( 16241 , "Currently only one hashed field per index supported." ,
+                hashedFields == 1 );
         uassert( 16242 , "Currently hashed indexes cannot guarantee uniqueness. Use a regular index." ,
                 ! (spec->info).getField("unique").booleanSafe() );
 
@@ -50,49 +55,81 @@ namespace mongo {
         //or if the value of "hashversion" is not a number
         _hashVersion = (spec->info).getField("hashVersion").numberInt();
 
-        //Get the hashfield name
-        BSONElement firstElt = spec->keyPattern.firstElement();
-        massert( 16243 , "error: no hashed index field" ,
-                firstElt.str().compare( HASHED_INDEX_TYPE_IDENTIFIER ) == 0 );
-        _hashedField = firstElt.fieldName();
+        //Get the hashfield name, and the ordered fields in front of it
+        BSONForEach( e , spec->keyPattern ) {
+            if ( e.type() == String ) {
+                massert( 16243 , "error: no hashed index field" ,
+                        e.str().compare( HASHED_INDEX_TYPE_IDENTIFIER ) == 0 );
+                _hashedField = e.fieldName();
+                break;
+            }
+            _prefixFields.push_back( e.fieldName() );
+        }
     }
 
     HashedIndexType::~HashedIndexType() { }
 
     IndexSuitability HashedIndexType::suitability( const BSONObj& query , const BSONObj& order ) const {
         FieldRangeSet frs( "" , query , true, true );
-        if ( frs.isPointIntervalSet( _hashedField ) )
+
+        bool prefixIsPoint = true;
+        for ( unsigned i = 0; i < _prefixFields.size(); i++ ) {
+            if ( ! frs.isPointIntervalSet( _prefixFields[ i ] ) ) {
+                prefixIsPoint = false;
+                break;
+            }
+        }
+
+        if ( frs.isPointIntervalSet( _hashedField ) ) {
+            // a point lookup answered straight from the keys, unless results must be sorted
+            return ( prefixIsPoint && order.isEmpty() ) ? OPTIMAL : HELPFUL;
+        }
+
+        // a constrained leading ordered field can still be scanned as a btree prefix
+        if ( ! _prefixFields.empty() &&
+             ! frs.range( _prefixFields[ 0 ].c_str() ).universal() )
             return HELPFUL;
+
         return USELESS;
     }
 
     void HashedIndexType::getKeys( const BSONObj &obj, BSONObjSet &keys ) const {
-        string hashedFieldCopy = string( _hashedField );
-        const char* hashedFieldCopyPtr = hashedFieldCopy.c_str();
-        BSONElement fieldVal = obj.getFieldDottedOrArray( hashedFieldCopyPtr );
+        BSONObjBuilder keyBuilder;
+        bool allMissing = true;
 
-        uassert( 16244 , "Error: hashed indexes do not currently support array values" , fieldVal.type() != Array );
+        BSONForEach( e , _spec->keyPattern ) {
+            string fieldCopy = string( e.fieldName() );
+            const char* fieldCopyPtr = fieldCopy.c_str();
+            BSONElement fieldVal = obj.getFieldDottedOrArray( fieldCopyPtr );
 
-        if ( ! fieldVal.eoo() ) {
-            BSONObj key = BSON( "" << makeSingleKey( fieldVal , _seed , _hashVersion  ) );
-            keys.insert( key );
-        }
-        else if (! _isSparse ) {
-            BSONObj nullobj = BSON( _hashedField << BSONNULL );
-            BSONElement nullElt = nullobj.firstElement();
-            BSONObj key = BSON( "" << makeSingleKey( nullElt , _seed , _hashVersion  ) );
-            keys.insert( key );
+            uassert( 16244 , "Error: hashed indexes do not currently support array values" , fieldVal.type() != Array );
+
+            if ( ! fieldVal.eoo() )
+                allMissing = false;
+            else
+                fieldVal = _spec->missingField();
+
+            if ( _hashedField == e.fieldName() )
+                keyBuilder.append( "" , makeSingleKey( fieldVal , _seed , _hashVersion ) );
+            else
+                keyBuilder.appendAs( fieldVal , "" );
         }
+
+        if ( allMissing && _isSparse )
+            return;
+
+        keys.insert( keyBuilder.obj() );
     }
 
     shared_ptr<Cursor> HashedIndexType::newCursor( const BSONObj& query ,
             const BSONObj& order , int numWanted ) const {
 
-        //Use FieldRangeSet to parse the query into a vector of intervals
-        //These should be point-intervals if this cursor is ever used
-        //So the FieldInterval vector will be, e.g. <[1,1], [3,3], [6,6]>
+        //Use FieldRangeSet to parse the query into a vector of intervals.  The
+        //FieldRangeVector replaces the point-intervals of the hashed field by their
+        //hashes, e.g. <[1,1], [3,3], [6,6]> becomes <[hash(1)], [hash(3)], [hash(6)]>,
+        //and scans the whole hashed field otherwise.
         FieldRangeSet frs( "" , query , true, true );
-        const vector<FieldInterval>& intervals = frs.range( _hashedField.c_str() ).intervals();
+        shared_ptr<FieldRangeVector> vector( new FieldRangeVector( frs , *_spec , 1 ) );
 
         //Force a match of the query against the actual document by giving
         //the cursor a matcher with an empty indexKeyPattern.  This insures the
@@ -101,38 +138,9 @@ namespace mongo {
         const shared_ptr< CoveredIndexMatcher > forceDocMatcher(
                 new CoveredIndexMatcher( query , BSONObj() ) );
 
-        //Construct a new query based on the hashes of the previous point-intervals
-        //e.g. {a : {$in : [ hash(1) , hash(3) , hash(6) ]}}
-        BSONObjBuilder newQueryBuilder;
-        BSONObjBuilder inObj( newQueryBuilder.subobjStart( _hashedField ) );
-        BSONArrayBuilder inArray( inObj.subarrayStart("$in") );
-        vector<FieldInterval>::const_iterator i;
-        for( i = intervals.begin(); i != intervals.end(); ++i ){
-            if ( ! i->equality() ){
-                const shared_ptr< BtreeCursor > exhaustiveCursor(
-                        BtreeCursor::make( nsdetails( _spec->getDetails()->parentNS().c_str()),
-                                           *( _spec->getDetails() ),
-                                           BSON( "" << MINKEY ) ,
-                                           BSON( "" << MAXKEY ) ,
-                                           true ,
-                                           1 ) );
-                exhaustiveCursor->setMatcher( forceDocMatcher );
-                return exhaustiveCursor;
-            }
-            inArray.append( makeSingleKey( i->_lower._bound , _seed , _hashVersion ) );
-        }
-        inArray.done();
-        inObj.done();
-        BSONObj newQuery = newQueryBuilder.obj();
-
-        //Use the point-intervals of the new query to create a Btree cursor
-        FieldRangeSet newfrs( "" , newQuery , true, true );
-        shared_ptr<FieldRangeVector> newVector(
-                new FieldRangeVector( newfrs , *_spec , 1 ) );
-
         const shared_ptr< BtreeCursor > cursor(
                 BtreeCursor::make( nsdetails( _spec->getDetails()->parentNS().c_str()),
-                        *( _spec->getDetails() ), newVector, 0, 1 ) );
+                        *( _spec->getDetails() ), vector, 0, 1 ) );
         cursor->setMatcher( forceDocMatcher );
         return cursor;
     }
@@ -25,7 +25,8 @@
 
 namespace mongo {
 
-    /* This is an index where the keys are hashes of a given field.
+    /* This is an index where the keys are hashes of a given field, optionally
+     * preceded by ordinary ascending/descending fields.
      *
      * Optional arguments:
      *  "seed" : int (default = 0, a seed for the hash function)
@@ -34,10 +35,13 @@ namespace mongo {
      * Example use in the mongo shell:
      * > db.foo.ensureIndex({a : "hashed"}, {seed : 3, hashVersion : 0})
      *
-     * LIMITATION: Only works with a single field. The HashedIndexType
-     * constructor uses uassert to ensure that the spec has the form
-     * {<fieldname> : "hashed"}, and not, for example,
-     * { a : "hashed" , b : 1}
+     * A compound form such as { tenant : 1 , userId : "hashed" } keys documents
+     * by { "" : tenant , "" : hash(userId) }, so queries on the ordered prefix
+     * scan a btree range while point lookups also use the hash.
+     *
+     * LIMITATION: Only one field may be hashed. The HashedIndexType
+     * constructor uses uassert to reject, for example,
+     * { a : "hashed" , b : "hashed" }
      *
      * LIMITATION: Cannot be used as a unique index.
      * The HashedIndexType constructor uses uassert to ensure that
@@ -62,24 +66,38 @@ namespace mongo {
         HashedIndexType( const IndexPlugin* plugin , const IndexSpec* spec );
         virtual ~HashedIndexType();
 
-        /* This index is only considered "HELPFUL" for a query
+        /* This index is only considered "OPTIMAL" for a query
          * if it's the union of at least one equality constraint on the
-         * hashed field.  Otherwise it's considered USELESS.
+         * hashed field and on every field before it, and no sort order is
+         * requested.  It is "HELPFUL" if the hashed field is constrained
+         * to points otherwise, or if the leading ordered field is
+         * constrained at all.  Otherwise it's considered USELESS.
+         * An OPTIMAL hashed plan is chosen by the query optimizer without
+         * racing the btree plans.
          * Example queries (supposing the indexKey is {a : "hashed"}):
-         *   {a : 3}  HELPFUL
-         *   {a : 3 , b : 3} HELPFUL
-         *   {a : {$in : [3,4]}} HELPFUL
-         *   {a : {$gte : 3, $lte : 3}} HELPFUL
+         *   {a : 3}  OPTIMAL
+         *   {a : 3 , b : 3} OPTIMAL
+         *   {a : {$in : [3,4]}} OPTIMAL
+         *   {a : {$gte : 3, $lte : 3}} OPTIMAL
+         *   {a : 3} sorted by {b : 1} HELPFUL
          *   {} USELESS
          *   {b : 3} USELESS
          *   {a : {$gt : 3}} USELESS
+         * Example queries (supposing the indexKey is {t : 1 , a : "hashed"}):
+         *   {t : 1 , a : 3} OPTIMAL
+         *   {t : {$gt : 1} , a : 3} HELPFUL
+         *   {t : 1} HELPFUL
+         *   {a : 3} HELPFUL
          */
         IndexSuitability suitability( const BSONObj& query , const BSONObj& order ) const;
 
         /* The input is "obj" which should have a field corresponding to the hashedfield.
-         * The output is a BSONObj with a single BSONElement whose value is the hash
+         * The output is a BSONObj with one BSONElement per index field, the hashed
+         * field's value being the hash
          * Eg if this is an index on "a" we have
          *   obj is {a : 45} --> key becomes {"" : hash(45) }
+         * and if this is an index on {t : 1 , a : "hashed"}
+         *   obj is {t : 2 , a : 45} --> key becomes {"" : 2 , "" : hash(45) }
          *
          * Limitation: arrays values are not currently supported.  This function uasserts
          * that the value is not an array, and errors out in that case.
@@ -87,8 +105,8 @@ namespace mongo {
         void getKeys( const BSONObj &obj, BSONObjSet &keys ) const;
 
         /* The newCursor method works for suitable queries by generating a BtreeCursor
-         * using the hash of point-intervals parsed by FieldRangeSet.
-         * For unsuitable queries it just instantiates a btree cursor over the whole tree
+         * over the FieldRangeVector of the query, which uses the hash of point-intervals
+         * parsed by FieldRangeSet for the hashed field and scans it fully otherwise.
          */
         shared_ptr<Cursor> newCursor( const BSONObj& query ,
                 const BSONObj& order , int numWanted ) const;
@@ -110,6 +128,7 @@ namespace mongo {
 
     private:
         string _hashedField;
+        vector<string> _prefixFields; // ordered fields in front of the hashed one
         KeyPattern _keyPattern;
         HashSeed _seed; //defaults to zero if not in the IndexSpec
         HashVersion _hashVersion; //defaults to zero if not in the IndexSpec
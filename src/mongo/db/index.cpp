@@ -27,6 +27,7 @@
 #include "mongo/db/index_update.h"
 #include "mongo/db/namespace-inl.h"
 #include "mongo/db/ops/delete.h"
+#include "mongo/db/queryutil.h"
 #include "mongo/db/repl/rs.h"
 #include "mongo/util/scopeguard.h"
 
@@ -372,6 +373,20 @@ namespace mongo {
         string pluginName = IndexPlugin::findPluginName( key );
         IndexPlugin * plugin = pluginName.size() ? IndexPlugin::get( pluginName ) : 0;
 
+        BSONElement filter = io["partialFilterExpression"];
+        if ( !filter.eoo() ) {
+            uassert( 16490, "partialFilterExpression must be an object", filter.type() == Object );
+            uassert( 16491, "the _id index cannot be partial", !IndexDetails::isIdIndexPattern(key) );
+            uassert( 16492, str::stream() << "partialFilterExpression is not supported for "
+                                          << pluginName << " indexes", pluginName.empty() );
+            // the optimizer decides whether a query implies the filter by comparing field ranges,
+            // so the ranges have to say exactly what the filter matches
+            FieldRangeSet frs( sourceNS.c_str(), filter.Obj(), true, true );
+            uassert( 16493, str::stream() << "partialFilterExpression may only hold equality and "
+                                          << "range predicates: " << filter.Obj(),
+                     frs.mustBeExactMatchRepresentation() && frs.matchPossible() );
+        }
+
 
         { 
             BSONObj o = io;
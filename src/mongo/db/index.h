@@ -211,6 +211,11 @@ namespace mongo {
             return info.obj().getBoolField( "dropDups" );
         }
 
+        /** @return true if only documents matching a partialFilterExpression are indexed */
+        bool isPartial() const {
+            return info.obj().hasField( "partialFilterExpression" );
+        }
+
         /** delete this index.  does NOT clean up the system catalog
             (system.indexes or system.namespaces) -- only NamespaceIndex.
         */
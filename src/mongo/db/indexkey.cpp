@@ -20,6 +20,8 @@
 #include "namespace-inl.h"
 #include "index.h"
 #include "background.h"
+#include "matcher.h"
+#include "queryutil.h"
 #include "../util/stringutils.h"
 #include "mongo/util/mongoutils/str.h"
 #include "../util/text.h"
@@ -81,6 +83,20 @@ namespace mongo {
         _sparse = info["sparse"].trueValue();
         uassert( 13529 , "sparse only works for single field keys" , ! _sparse || _nFields );
 
+        {
+            // partial indexes
+            BSONElement filter = info["partialFilterExpression"];
+            if ( filter.isABSONObj() ) {
+                BSONObj f = filter.Obj().getOwned();
+                _filter.reset( new Matcher( f ) );
+                _filterRanges.reset( new FieldRangeSet( "" , f , true , true ) );
+            }
+            else {
+                _filter.reset();
+                _filterRanges.reset();
+            }
+        }
+
 
         {
             // build _nullKey
@@ -405,6 +421,8 @@ namespace mongo {
     };
     
     void IndexSpec::getKeys( const BSONObj &obj, BSONObjSet &keys ) const {
+        if ( _filter && ! _filter->matches( obj ) )
+            return;
         switch( indexVersion() ) {
             case 0: {
                 KeyGeneratorV0 g( *this );
@@ -461,6 +479,22 @@ namespace mongo {
         return IndexDetails::versionForIndexObj( info );
     }    
 
+    bool IndexSpec::filterImpliedBy( const FieldRangeSet& frs ) const {
+        if ( ! _filter )
+            return true;
+        // The filter's ranges represent it exactly (checked when the index is built), so a query
+        // whose range on each filtered field lies within the filter's range can only match
+        // indexed documents.
+        const map<string,FieldRange>& ranges = _filterRanges->ranges();
+        for ( map<string,FieldRange>::const_iterator i = ranges.begin(); i != ranges.end(); ++i ) {
+            if ( i->second.universal() )
+                continue;
+            if ( ! ( frs.range( i->first.c_str() ) <= i->second ) )
+                return false;
+        }
+        return true;
+    }
+
     bool IndexType::scanAndOrderRequired( const BSONObj& query , const BSONObj& order ) const {
         return ! order.isEmpty();
     }
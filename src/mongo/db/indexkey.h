@@ -30,6 +30,8 @@ namespace mongo {
     const int ParallelArraysCode = 10088;
     
     class Cursor;
+    class FieldRangeSet;
+    class Matcher;
     class IndexSpec;
     class IndexType; // TODO: this name sucks
     class IndexPlugin;
@@ -165,6 +167,17 @@ namespace mongo {
 
         bool isSparse() const { return _sparse; }
 
+        /** @return true if only documents matching the index's partialFilterExpression have keys */
+        bool isPartial() const { return _filter.get() != 0; }
+
+        /**
+         * @return true if every document matching a query with field ranges 'frs' also matches
+         *         the partialFilterExpression, so the index holds all the query's results.
+         *         'frs' should be built for multikey use, so that ranges on one field aren't
+         *         intersected in ways an array value wouldn't honour.
+         */
+        bool filterImpliedBy( const FieldRangeSet& frs ) const;
+
     protected:
 
         int indexVersion() const;
@@ -184,6 +197,8 @@ namespace mongo {
 
         int _nFields; // number of fields in the index
         bool _sparse; // if the index is sparse
+        shared_ptr<Matcher> _filter; // documents not matching aren't indexed, if set
+        shared_ptr<FieldRangeSet> _filterRanges; // exact ranges of _filter
         shared_ptr<IndexType> _indexType;
         const IndexDetails * _details;
 
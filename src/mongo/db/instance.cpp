@@ -50,7 +50,9 @@
 #include "mongo/db/replutil.h"
 #include "mongo/db/security.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/op_latencies.h"
 #include "mongo/s/d_logic.h"
+#include "mongo/util/arena.h"
 #include "mongo/util/file_allocator.h"
 #include "mongo/util/goodies.h"
 
@@ -324,6 +326,8 @@ namespace mongo {
 
     // Returns false when request includes 'end'
     void assembleResponse( Message &m, DbResponse &dbresponse, const HostAndPort& remote ) {
+        // scratch memory of this request is released in one go when it's done
+        Arena::OpScope opArena;
 
         // before we lock...
         int op = m.operation();
@@ -461,6 +465,11 @@ namespace mongo {
         currentOp.ensureStarted();
         currentOp.done();
         debug.executionTime = currentOp.totalTimeMillis();
+        globalOpLatencies.record( op , isCommand , currentOp.totalTimeMicros() );
+        if ( Arena::current()->allocations() > 0 ) {
+            debug.arenaAllocs = Arena::current()->allocations();
+            debug.arenaBytes = Arena::current()->bytesAllocated();
+        }
 
         logThreshold += currentOp.getExpectedLatencyMs();
 
@@ -646,7 +655,8 @@ namespace mongo {
         scoped_ptr<Timer> timer;
         int pass = 0;
         bool exhaust = false;
-        QueryResult* msgdata = 0;
+        auto_ptr<Message> resp( new Message() );
+        bool gotMore = false;
         OpTime last;
         while( 1 ) {
             try {
@@ -663,7 +673,7 @@ namespace mongo {
                     }
                 }
 
-                msgdata = processGetMore(ns, ntoreturn, cursorid, curop, pass, exhaust);
+                gotMore = processGetMore(ns, ntoreturn, cursorid, curop, pass, exhaust, *resp);
             }
             catch ( AssertionException& e ) {
                 ex.reset( new AssertionException( e.getInfo().msg, e.getCode() ) );
@@ -671,7 +681,7 @@ namespace mongo {
                 break;
             }
             
-            if (msgdata == 0) {
+            if ( !gotMore ) {
                 // this should only happen with QueryOption_AwaitData
                 exhaust = false;
                 massert(13073, "shutting down", !inShutdown() );
@@ -718,15 +728,15 @@ namespace mongo {
                 return ok;
             }
 
-            msgdata = emptyMoreResult(cursorid);
+            // drop any part of the reply built before the exception
+            resp->reset();
+            resp->setData(emptyMoreResult(cursorid), true);
         }
 
-        Message *resp = new Message();
-        resp->setData(msgdata, true);
         curop.debug().responseLength = resp->header()->dataLen();
-        curop.debug().nreturned = msgdata->nReturned;
+        curop.debug().nreturned = ((QueryResult*) resp->header())->nReturned;
 
-        dbresponse.response = resp;
+        dbresponse.response = resp.release();
         dbresponse.responseTo = m.header()->id;
         
         if( exhaust ) {
@@ -738,15 +748,7 @@ namespace mongo {
     }
 
     void checkAndInsert(const char *ns, /*modifies*/BSONObj& js) { 
-        uassert( 10059 , "object to insert too large", js.objsize() <= BSONObjMaxUserSize);
-        {
-            // check no $ modifiers.  note we only check top level.  (scanning deep would be quite expensive)
-            BSONObjIterator i( js );
-            while ( i.more() ) {
-                BSONElement e = i.next();
-                uassert( 13511 , "document to insert can't have $ fields" , e.fieldName()[0] != '$' );
-            }
-        }
+        checkUserInsert( js );
         theDataFileMgr.insertWithObjMod(ns,
                                         // May be modified in the call to add an _id field.
                                         js,
@@ -760,6 +762,19 @@ namespace mongo {
     }
 
     NOINLINE_DECL void insertMulti(bool keepGoing, const char *ns, vector<BSONObj>& objs) {
+        if ( DataFileMgr::canInsertBatch( ns ) ) {
+            size_t n = 0;
+            try {
+                theDataFileMgr.insertBatch( ns, objs, keepGoing, n );
+            }
+            catch ( const UserException& ) {
+                globalOpCounters.incInsertInWriteLock( n );
+                throw;
+            }
+            globalOpCounters.incInsertInWriteLock( n );
+            return;
+        }
+
         size_t i;
         for (i=0; i<objs.size(); i++){
             try {
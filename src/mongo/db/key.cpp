@@ -514,6 +514,40 @@ namespace mongo {
         return 0;
     }
 
+    static unsigned sizes[] = {
+        0,
+        1, //cminkey=1,
+        1, //cnull=2,
+        0,
+        9, //cdouble=4,
+        0,
+        0, //cstring=6,
+        0,
+        13, //coid=8,
+        0,
+        1, //cfalse=10,
+        1, //ctrue=11,
+        9, //cdate=12,
+        0,
+        1, //cmaxkey=14,
+        0
+    };
+
+    inline unsigned sizeOfElement(const unsigned char *p) { 
+        unsigned type = *p & cCANONTYPEMASK;
+        unsigned sz = sizes[type];
+        if( sz == 0 ) {
+            if( type == cstring ) { 
+                sz = ((unsigned) p[1]) + 2;
+            }
+            else {
+                verify( type == cbindata );
+                sz = binDataCodeToLength(p[1]) + 2;
+            }
+        }
+        return sz;
+    }
+
     // at least one of this and right are traditional BSON format
     int NOINLINE_DECL KeyV1::compareHybrid(const KeyV1& right, const Ordering& order) const { 
         BSONObj L = toBson();
@@ -529,6 +563,22 @@ namespace mongo {
             return compareHybrid(right, order);
 
         unsigned mask = 1;
+
+        // Compact elements with identical bytes always compare equal (NaN, the one value
+        // not equal to itself, is never stored compactly), so step over a shared prefix of
+        // elements without decoding them; compound keys in a bucket usually share one.
+        // Comparing the type byte and the following (size) byte first keeps us within the
+        // right hand element when the two differ in length.
+        while( *l == *r ) {
+            unsigned sz = sizeOfElement(l);
+            if( sz > 1 && ( l[1] != r[1] || memcmp(l + 2, r + 2, sz - 2) ) )
+                break;
+            if( (*l & cHASMORE) == 0 )
+                return 0;
+            l += sz; r += sz;
+            mask <<= 1;
+        }
+
         while( 1 ) { 
             char lval = *l; 
             char rval = *r;
@@ -555,40 +605,6 @@ namespace mongo {
         return 0;
     }
 
-    static unsigned sizes[] = {
-        0,
-        1, //cminkey=1,
-        1, //cnull=2,
-        0,
-        9, //cdouble=4,
-        0,
-        0, //cstring=6,
-        0,
-        13, //coid=8,
-        0,
-        1, //cfalse=10,
-        1, //ctrue=11,
-        9, //cdate=12,
-        0,
-        1, //cmaxkey=14,
-        0
-    };
-
-    inline unsigned sizeOfElement(const unsigned char *p) { 
-        unsigned type = *p & cCANONTYPEMASK;
-        unsigned sz = sizes[type];
-        if( sz == 0 ) {
-            if( type == cstring ) { 
-                sz = ((unsigned) p[1]) + 2;
-            }
-            else {
-                verify( type == cbindata );
-                sz = binDataCodeToLength(p[1]) + 2;
-            }
-        }
-        return sz;
-    }
-
     int KeyV1::dataSize() const { 
         const unsigned char *p = _keyData;
         if( !isCompactFormat() ) {
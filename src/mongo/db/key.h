@@ -19,6 +19,7 @@
 #pragma once
  
 #include "jsobj.h"
+#include "mongo/util/arena.h"
 
 namespace mongo { 
 
@@ -111,7 +112,7 @@ namespace mongo {
         KeyV1Owned(const KeyV1& rhs);
 
     private:
-        StackBufBuilder b;
+        ArenaBufBuilder b;
         void traditional(const BSONObj& obj); // store as traditional bson not as compact format
     };
 
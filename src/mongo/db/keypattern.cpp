@@ -27,14 +27,22 @@ namespace mongo {
         if ( _pattern.isEmpty() )
             return BSONObj();
 
-        if ( mongoutils::str::equals( _pattern.firstElement().valuestrsafe() , "hashed" ) ){
-            BSONElement fieldVal = doc.getFieldDotted( _pattern.firstElementFieldName() );
-            return BSON( _pattern.firstElementFieldName() <<
-                         BSONElementHasher::hash64( fieldVal ,
-                                                    BSONElementHasher::DEFAULT_HASH_SEED ) );
+        if ( ! isSpecial() )
+            return doc.extractFields( _pattern );
+
+        BSONObjBuilder b;
+        BSONForEach( patternElt , _pattern ) {
+            BSONElement fieldVal = doc.getFieldDotted( patternElt.fieldName() );
+            if ( isHashed( patternElt ) ) {
+                b.append( patternElt.fieldName() ,
+                          BSONElementHasher::hash64( fieldVal ,
+                                                     BSONElementHasher::DEFAULT_HASH_SEED ) );
+            }
+            else if ( ! fieldVal.eoo() ) {
+                b.appendAs( fieldVal , patternElt.fieldName() );
+            }
         }
-
-        return doc.extractFields( _pattern );
+        return b.obj();
     }
 
     bool KeyPattern::isSpecial() const {
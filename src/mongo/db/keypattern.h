@@ -102,6 +102,9 @@ namespace mongo {
          *
          *  If 'this' KeyPattern is { a  : "hashed" }
          *   { a: 1 } --> returns { a : NumberLong("5902408780260971510")  }
+         *
+         *  If 'this' KeyPattern is { a : 1 , b : "hashed" }
+         *   { a : 2 , b : 1 } --> returns { a : 2 , b : NumberLong("5902408780260971510") }
          */
         BSONObj extractSingleKey( const BSONObj& doc ) const;
 
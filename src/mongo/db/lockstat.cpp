@@ -27,41 +27,51 @@ namespace mongo {
         BSONObjBuilder b;
 
         BSONObjBuilder t( b.subobjStart( "timeLockedMicros" ) );
-        _append( b , timeLocked );
+        _append( t , TimeLocked );
         t.done();
         
         BSONObjBuilder a( b.subobjStart( "timeAcquiringMicros" ) );
-        _append( a , timeAcquiring );
+        _append( a , TimeAcquiring );
         a.done();
         
         return b.obj();
     }
 
     void LockStat::report( StringBuilder& builder ) const {
+        _report( builder , TimeLocked , "locks(micros)" );
+        _report( builder , TimeAcquiring , " acquiring(micros)" );
+    }
+
+    void LockStat::_report( StringBuilder& builder, int base, const char* prefix ) const {
         bool prefixPrinted = false;
         for ( int i=0; i < N; i++ ) {
-            if ( timeLocked[i].load() == 0 )
+            long long micros = _counters.get( base + i );
+            if ( micros == 0 )
                 continue;
             
             if ( ! prefixPrinted ) {
-                builder << "locks(micros)";
+                builder << prefix;
                 prefixPrinted = true;
             }
 
-            builder << ' ' << nameFor( i ) << ':' << timeLocked[i].load();
+            builder << ' ' << nameFor( i ) << ':' << micros;
         }
         
     }
 
-    void LockStat::_append( BSONObjBuilder& builder, const AtomicInt64* data ) {
-        if ( data[0].load() || data[1].load() ) {
-            builder.append( "R" , data[0].load() );
-            builder.append( "W" , data[1].load() );
+    void LockStat::_append( BSONObjBuilder& builder, int base ) const {
+        long long data[N];
+        for ( int i = 0; i < N; i++ )
+            data[i] = _counters.get( base + i );
+
+        if ( data[0] || data[1] ) {
+            builder.append( "R" , data[0] );
+            builder.append( "W" , data[1] );
         }
         
-        if ( data[2].load() || data[3].load() ) {
-            builder.append( "r" , data[2].load() );
-            builder.append( "w" , data[3].load() );
+        if ( data[2] || data[3] ) {
+            builder.append( "r" , data[2] );
+            builder.append( "w" , data[3] );
         }
     }
 
@@ -89,16 +99,13 @@ namespace mongo {
 
 
     void LockStat::recordAcquireTimeMicros( char type , long long micros ) {
-        timeAcquiring[mapNo(type)].fetchAndAdd( micros );
+        _counters.add( TimeAcquiring + mapNo(type) , micros );
     }
     void LockStat::recordLockTimeMicros( char type , long long micros ) {
-        timeLocked[mapNo(type)].fetchAndAdd( micros );
+        _counters.add( TimeLocked + mapNo(type) , micros );
     }
 
     void LockStat::reset() {
-        for ( int i = 0; i < N; i++ ) {
-            timeAcquiring[i].store(0);
-            timeLocked[i].store(0);
-        }
+        _counters.reset();
     }
 }
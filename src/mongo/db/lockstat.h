@@ -20,7 +20,7 @@
 #pragma once
 
 #include "util/timer.h"
-#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/striped_counter.h"
 
 namespace mongo { 
 
@@ -35,16 +35,17 @@ namespace mongo {
         void reset();
 
         BSONObj report() const;
+        /** time locked then time acquiring, for the slow op log line */
         void report( StringBuilder& builder ) const;
 
-        long long getTimeLocked( char type ) const { return timeLocked[mapNo(type)].load(); }
+        long long getTimeLocked( char type ) const { return _counters.get( TimeLocked + mapNo(type) ); }
     private:
-        static void _append( BSONObjBuilder& builder, const AtomicInt64* data );
+        void _append( BSONObjBuilder& builder, int base ) const;
+        void _report( StringBuilder& builder, int base, const char* prefix ) const;
         
-        // RWrw
-        // in micros
-        AtomicInt64 timeAcquiring[N];
-        AtomicInt64 timeLocked[N];
+        // RWrw for each, in micros
+        enum { TimeAcquiring = 0 , TimeLocked = N };
+        StripedCounters<2 * N> _counters;
 
         static unsigned mapNo(char type);
         static char nameFor(unsigned offset);
@@ -21,6 +21,7 @@
 #include "mongo/db/d_concurrency.h"
 #include "mongo/db/namespacestring.h"
 #include "mongo/db/client.h"
+#include "mongo/db/curop.h"
 #include "mongo/util/mongoutils/str.h"
 #include "lockstate.h"
 
@@ -36,7 +37,8 @@ namespace mongo {
           _otherLock(NULL),
           _scopedLk(NULL),
           _lockPending(false),
-          _lockPendingParallelWriter(false)
+          _lockPendingParallelWriter(false),
+          _queueClass(Lock::Unscheduled)
     {
     }
 
@@ -231,11 +233,17 @@ namespace mongo {
 
 
     Acquiring::Acquiring( Lock::ScopedLock* lock,  LockState& ls )
-        : _lock( lock ), _ls( ls ){
+        : _lock( lock ), _ls( ls ), _op( cc().curop() ), _prevStage( OpStageOther ) {
         _ls._lockPending = true;
+        if ( _op ) {
+            _prevStage = _op->stage();
+            _op->setStage( OpStageLockWait );
+        }
     }
 
     Acquiring::~Acquiring() {
+        if ( _op )
+            _op->setStage( static_cast<OpStage>( _prevStage ) );
         _ls._lockPending = false;
         LockStat* stat = _ls.getRelevantLockStat();
         if ( stat && _lock )
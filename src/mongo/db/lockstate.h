@@ -23,6 +23,8 @@
 
 namespace mongo {
 
+    class CurOp;
+
     class Acquiring;
 
     // per thread
@@ -81,6 +83,10 @@ namespace mongo {
         void unlockedOther();
         bool _batchWriter;
 
+        /** Lock::QueueClass */
+        int queueClass() const { return _queueClass; }
+        void setQueueClass( int c ) { _queueClass = c; }
+
         LockStat* getRelevantLockStat();
         void recordLockTime() { _scopedLk->recordTime(); }
         void resetLockTime() { _scopedLk->resetTime(); }
@@ -107,6 +113,8 @@ namespace mongo {
         bool _lockPending;
         bool _lockPendingParallelWriter;
 
+        int _queueClass;
+
         friend class Acquiring;
         friend class AcquiringParallelWriter;
     };
@@ -132,6 +140,8 @@ namespace mongo {
     private:
         Lock::ScopedLock* _lock;
         LockState& _ls;
+        CurOp* _op;
+        int _prevStage; // of _op
     };
         
     class AcquiringParallelWriter {
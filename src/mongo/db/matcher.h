@@ -316,15 +316,21 @@ namespace mongo {
         bool matches( const BSONObj& key, const DiskLoc& recLoc, MatchDetails* details = 0,
                       bool keyUsable = true ) const;
         bool isOrClauseDup( const BSONObj &obj ) const;
+        /** @return true if 'prevClauseFrv' can be checked against this index's keys alone. */
+        bool orClauseDupCheckableOnKey( FieldRangeVector &prevClauseFrv ) const;
+        /** @return 'key' with this index's field names, enough for an $or clause dup check. */
+        BSONObj keyWithFieldNames( const BSONObj &key ) const;
         CoveredIndexMatcher( const CoveredIndexMatcher &prevClauseMatcher,
                             const shared_ptr<FieldRangeVector> &prevClauseFrv,
                             const BSONObj &nextClauseIndexKeyPattern );
         void init();
         shared_ptr< Matcher > _docMatcher;
         Matcher _keyMatcher;
+        BSONObj _indexKeyPattern;
         vector<shared_ptr<FieldRangeVector> > _orDedupConstraints;
 
         bool _needRecord; // if the key itself isn't good enough to determine a positive match
+        bool _orDedupOnKey; // if prior $or clauses can be ruled out from the key alone
     };
 
 } // namespace mongo
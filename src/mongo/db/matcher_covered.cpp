@@ -31,7 +31,8 @@ namespace mongo {
     CoveredIndexMatcher::CoveredIndexMatcher( const BSONObj &jsobj,
                                              const BSONObj &indexKeyPattern ) :
         _docMatcher( new Matcher( jsobj ) ),
-        _keyMatcher( *_docMatcher, indexKeyPattern ) {
+        _keyMatcher( *_docMatcher, indexKeyPattern ),
+        _indexKeyPattern( indexKeyPattern ) {
         init();
     }
 
@@ -40,6 +41,7 @@ namespace mongo {
                                              const BSONObj &nextClauseIndexKeyPattern ) :
         _docMatcher( prevClauseMatcher._docMatcher ),
         _keyMatcher( *_docMatcher, nextClauseIndexKeyPattern ),
+        _indexKeyPattern( nextClauseIndexKeyPattern ),
         _orDedupConstraints( prevClauseMatcher._orDedupConstraints ) {
         if ( prevClauseFrv ) {
             _orDedupConstraints.push_back( prevClauseFrv );
@@ -48,9 +50,50 @@ namespace mongo {
     }
 
     void CoveredIndexMatcher::init() {
+        _orDedupOnKey = true;
+        for( vector<shared_ptr<FieldRangeVector> >::const_iterator i = _orDedupConstraints.begin();
+            i != _orDedupConstraints.end(); ++i ) {
+            if ( !orClauseDupCheckableOnKey( **i ) ) {
+                _orDedupOnKey = false;
+                break;
+            }
+        }
         _needRecord =
             !_keyMatcher.keyMatch( *_docMatcher ) ||
-            !_orDedupConstraints.empty();
+            !_orDedupOnKey;
+    }
+
+    bool CoveredIndexMatcher::orClauseDupCheckableOnKey( FieldRangeVector &prevClauseFrv ) const {
+        // Keys of plugin index types don't hold the field values.
+        BSONForEach( e, _indexKeyPattern ) {
+            if ( !e.isNumber() ) {
+                return false;
+            }
+        }
+        // The prior clause's keys must be computable from this index's key, which holds null
+        // for a missing field.  Sparse and partial indexes skip documents depending on fields
+        // the key may not hold, so they are ruled out.
+        const IndexSpec &prevSpec = prevClauseFrv.getSpec();
+        if ( prevSpec.getType() || prevSpec.isSparse() || prevSpec.isPartial() ) {
+            return false;
+        }
+        BSONForEach( e, prevSpec.keyPattern ) {
+            if ( str::contains( e.fieldName(), '.' ) ||
+                !_indexKeyPattern.hasField( e.fieldName() ) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    BSONObj CoveredIndexMatcher::keyWithFieldNames( const BSONObj &key ) const {
+        BSONObjBuilder b;
+        BSONObjIterator k( key );
+        BSONObjIterator p( _indexKeyPattern );
+        while( k.more() && p.more() ) {
+            b.appendAs( k.next(), p.next().fieldName() );
+        }
+        return b.obj();
     }
 
     bool CoveredIndexMatcher::matchesCurrent( Cursor * cursor , MatchDetails * details ) const {
@@ -77,7 +120,10 @@ namespace mongo {
             }
             bool needRecordForDetails = details && details->needRecord();
             if ( !_needRecord && !needRecordForDetails ) {
-                return true;
+                // A non multikey index holds the values of its fields, so the prior $or
+                // clauses may be checked without loading the record.
+                return _orDedupConstraints.empty() ||
+                       !isOrClauseDup( keyWithFieldNames( key ) );
             }
         }
 
@@ -111,6 +157,9 @@ namespace mongo {
         if ( _needRecord )
             buf << "needRecord ";
         
+        if ( !_orDedupConstraints.empty() && _orDedupOnKey )
+            buf << "orDedupOnKey ";
+        
         buf << "keyMatcher: " << _keyMatcher.toString() << " ";
         
         if ( _docMatcher )
@@ -71,6 +71,9 @@ namespace mongo {
         IndexIterator i = ii();
         while( i.more() ) {
             const IndexDetails& currentIndex = i.next();
+            // a partial index doesn't hold every document in a key range
+            if( currentIndex.isPartial() )
+                continue;
             if( keyPattern.isPrefixOf( currentIndex.keyPattern() ) ){
                 if( ! isMultikey( i.pos()-1 ) ){
                     return &currentIndex;
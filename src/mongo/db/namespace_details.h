@@ -305,7 +305,8 @@ namespace mongo {
 
         /* Returns the index entry for the first index whose prefix contains
          * 'keyPattern'. If 'requireSingleKey' is true, skip indices that contain
-         * array attributes. Otherwise, returns NULL.
+         * array attributes. Partial indexes are skipped, as they may lack documents in the
+         * range. Otherwise, returns NULL.
          */
         const IndexDetails* findIndexByPrefix( const BSONObj &keyPattern ,
                                                bool requireSingleKey );
@@ -80,13 +80,65 @@ namespace mongo {
         return qr;
     }
 
-    QueryResult* processGetMore(const char *ns, int ntoreturn, long long cursorid , CurOp& curop, int pass, bool& exhaust ) {
-        exhaust = false;
+    /**
+     * Builds a reply in segments, handing each to a Message once it fills.  The Message sends its
+     * segments with a single scatter/gather write, so a batch is neither reserved at its largest
+     * possible size up front nor copied when a single buffer outgrows its allocation.
+     *
+     * The documents are still copied out of their records: the reply is sent after the read lock
+     * is released, when the records may be moved or deleted.
+     */
+    class SegmentedReplyBuilder : boost::noncopyable {
+    public:
+        static const int SegmentSize = 256 * 1024;
+
+        SegmentedReplyBuilder( Message &result ) :
+            _result( result ),
+            _buf( new BufBuilder( SegmentSize ) ),
+            _handedOffLen() {
+            _buf->skip( sizeof( QueryResult ) );
+        }
 
-        int bufSize = 512 + sizeof( QueryResult ) + MaxBytesToReturnToClientAtOnce;
+        /** The segment to append to. */
+        BufBuilder &buf() { return *_buf; }
 
-        BufBuilder b( bufSize );
-        b.skip(sizeof(QueryResult));
+        /** @return the length of the reply so far. */
+        int len() const { return _handedOffLen + _buf->len(); }
+
+        /** Hands the current segment to the Message if it is full. */
+        void segmentDone() {
+            if ( _buf->len() < SegmentSize ) {
+                return;
+            }
+            handOff();
+            _buf.reset( new BufBuilder( SegmentSize ) );
+        }
+
+        /** @return the reply header, after handing the last segment to the Message. */
+        QueryResult *finish() {
+            handOff();
+            return (QueryResult *) _result.header();
+        }
+
+    private:
+        void handOff() {
+            if ( _buf->len() == 0 ) {
+                return;
+            }
+            _result.appendData( _buf->buf(), _buf->len() );
+            _handedOffLen += _buf->len();
+            _buf->decouple();
+        }
+
+        Message &_result;
+        scoped_ptr<BufBuilder> _buf;
+        int _handedOffLen;
+    };
+
+    bool processGetMore(const char *ns, int ntoreturn, long long cursorid , CurOp& curop, int pass, bool& exhaust, Message& result ) {
+        exhaust = false;
+
+        SegmentedReplyBuilder reply( result );
         int resultFlags = ResultFlag_AwaitCapable;
         int start = 0;
         int n = 0;
@@ -124,6 +176,7 @@ namespace mongo {
             // This manager may be stale, but it's the state of chunking when the cursor was created.
             ShardChunkManagerPtr manager = cc->getChunkManager();
 
+            CurOp::StageScope scanning( &curop , OpStageScan );
             while ( 1 ) {
                 if ( !c->ok() ) {
                     if ( c->tailable() ) {
@@ -135,7 +188,7 @@ namespace mongo {
                             continue;
 
                         if( n == 0 && (queryOptions & QueryOption_AwaitData) && pass < 1000 ) {
-                            return 0;
+                            return false;
                         }
 
                         break;
@@ -154,6 +207,7 @@ namespace mongo {
                     details.requestElemMatchKey();
                 }
 
+                curop.setStage( OpStageMatch );
                 // in some cases (clone collection) there won't be a matcher
                 if ( !c->currentMatches( &details ) ) {
                 }
@@ -168,15 +222,18 @@ namespace mongo {
                         last = c->currLoc();
                         n++;
 
-                        cc->fillQueryResultFromObj( b, &details );
+                        cc->fillQueryResultFromObj( reply.buf(), &details );
+                        reply.segmentDone();
 
-                        if ( ( ntoreturn && n >= ntoreturn ) || b.len() > MaxBytesToReturnToClientAtOnce ) {
+                        if ( ( ntoreturn && n >= ntoreturn ) || reply.len() > MaxBytesToReturnToClientAtOnce ) {
+                            curop.setStage( OpStageScan );
                             c->advance();
                             cc->incPos( n );
                             break;
                         }
                     }
                 }
+                curop.setStage( OpStageScan );
                 c->advance();
 
                 if ( ! cc->yieldSometimes( ( c->ok() && c->keyFieldsOnly() ) ?
@@ -202,16 +259,15 @@ namespace mongo {
             }
         }
 
-        QueryResult *qr = (QueryResult *) b.buf();
-        qr->len = b.len();
+        // qr->len is updated by appendData()
+        QueryResult *qr = reply.finish();
         qr->setOperation(opReply);
         qr->_resultFlags() = resultFlags;
         qr->cursorId = cursorid;
         qr->startingFrom = start;
         qr->nReturned = n;
-        b.decouple();
 
-        return qr;
+        return true;
     }
 
     ResultDetails::ResultDetails() :
@@ -690,6 +746,7 @@ namespace mongo {
         ClientCursor::Holder ccPointer( new ClientCursor( QueryOption_NoCursorTimeout, cursor,
                                                          ns ) );
         
+        CurOp::StageScope scanning( &curop , OpStageScan );
         for( ; cursor->ok(); cursor->advance() ) {
 
             bool yielded = false;
@@ -716,7 +773,10 @@ namespace mongo {
                 break;
             }
             
-            if ( !queryResponseBuilder->addMatch() ) {
+            curop.setStage( OpStageMatch );
+            bool matched = queryResponseBuilder->addMatch();
+            curop.setStage( OpStageScan );
+            if ( !matched ) {
                 continue;
             }
             
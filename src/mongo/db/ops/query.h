@@ -34,7 +34,12 @@ namespace mongo {
     class QueryOptimizerCursor;
     class QueryPlanSummary;
     
-    QueryResult* processGetMore(const char *ns, int ntoreturn, long long cursorid , CurOp& op, int pass, bool& exhaust);
+    /**
+     * Fills 'result' with the next batch of the cursor.
+     * @return false if the cursor awaits data and nothing was returned yet, leaving 'result'
+     * empty.
+     */
+    bool processGetMore(const char *ns, int ntoreturn, long long cursorid , CurOp& op, int pass, bool& exhaust, Message& result);
 
     string runQuery(Message& m, QueryMessage& q, CurOp& curop, Message &result);
 
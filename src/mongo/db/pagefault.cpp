@@ -21,6 +21,7 @@
 #include "diskloc.h"
 #include "pagefault.h"
 #include "client.h"
+#include "curop.h"
 #include "pdfile.h"
 #include "server.h"
 
@@ -39,6 +40,7 @@ namespace mongo {
         if ( Lock::isLocked() ) {
             warning() << "PageFaultException::touch happening with a lock" << endl;
         }
+        CurOp::StageScope faulting( OpStagePageFault );
         LockMongoFilesShared lk;
         if( LockMongoFilesShared::getEra() != era ) {
             // files opened and closed.  we don't try to handle but just bail out; this is much simpler
@@ -32,6 +32,7 @@ _ disallow system* manipulations from the database.
 #include <list>
 
 #include "mongo/base/counter.h"
+#include "mongo/bson/mutable/damage_vector.h"
 #include "mongo/db/pdfile_private.h"
 #include "mongo/db/background.h"
 #include "mongo/db/btree.h"
@@ -1058,6 +1059,7 @@ namespace mongo {
 
     void DataFileMgr::deleteRecord(NamespaceDetails* d, const char *ns, Record *todelete, const DiskLoc& dl, bool cappedOK, bool noWarn, bool doLog ) {
         dassert( todelete == dl.rec() );
+        CurOp::StageScope writing( OpStageWrite );
 
         if ( d->isCapped() && !cappedOK ) {
             out() << "failing remove on a capped ns " << ns << endl;
@@ -1091,6 +1093,36 @@ namespace mongo {
 
     /** Note: if the object shrinks a lot, we don't free up space, we leave extra at end of the record.
      */
+    /**
+     * Writes 'objNew' over the record holding 'objOld', declaring (and so journaling) only the
+     * byte ranges that changed.  A small $set or $inc that had to rebuild a large document then
+     * costs a few journaled bytes rather than the whole document.
+     */
+    static void writeChangedBytes( Record *toupdate, const BSONObj& objOld,
+                                   const BSONObj& objNew ) {
+        // Roughly the journal's header for each declared range, so nearby ranges are merged
+        // and a long list of scattered ones loses to a single write.
+        const size_t rangeOverhead = 16;
+
+        mutablebson::DamageVector damages;
+        mutablebson::computeDamages( objOld.objdata(), objOld.objsize(),
+                                     objNew.objdata(), objNew.objsize(),
+                                     rangeOverhead, &damages );
+
+        int sz = objNew.objsize();
+        if ( mutablebson::damagedBytes( damages ) + damages.size() * rangeOverhead >=
+             static_cast<size_t>( sz ) ) {
+            memcpy(getDur().writingPtr(toupdate->data(), sz), objNew.objdata(), sz);
+            return;
+        }
+
+        for ( mutablebson::DamageVector::const_iterator i = damages.begin();
+              i != damages.end(); ++i ) {
+            memcpy( getDur().writingPtr( toupdate->data() + i->offset, i->size ),
+                    objNew.objdata() + i->offset, i->size );
+        }
+    }
+
     const DiskLoc DataFileMgr::updateRecord(
         const char *ns,
         NamespaceDetails *d,
@@ -1099,6 +1131,7 @@ namespace mongo {
         const char *_buf, int _len, OpDebug& debug,  bool god) {
 
         dassert( toupdate == dl.rec() );
+        CurOp::StageScope writing( OpStageWrite );
 
         BSONObj objOld = BSONObj::make(toupdate);
         BSONObj objNew(_buf);
@@ -1188,8 +1221,7 @@ namespace mongo {
         }
 
         //  update in place
-        int sz = objNew.objsize();
-        memcpy(getDur().writingPtr(toupdate->data(), sz), objNew.objdata(), sz);
+        writeChangedBytes( toupdate, objOld, objNew );
         return dl;
     }
 
@@ -1470,6 +1502,7 @@ namespace mongo {
                                 bool god,
                                 bool mayAddIndex,
                                 bool* addedID) {
+        CurOp::StageScope writing( OpStageWrite );
         bool wouldAddIndex = false;
         massert( 10093 , "cannot insert into reserved $ collection", god || NamespaceString::normal( ns ) );
         uassert( 10094 , str::stream() << "invalid ns: " << ns , isValidNS( ns ) );
@@ -1646,6 +1679,217 @@ namespace mongo {
         return loc;
     }
 
+    void checkUserInsert( const BSONObj& js ) {
+        uassert( 10059 , "object to insert too large", js.objsize() <= BSONObjMaxUserSize);
+        // check no $ modifiers.  note we only check top level.  (scanning deep would be quite expensive)
+        BSONObjIterator i( js );
+        while ( i.more() ) {
+            BSONElement e = i.next();
+            uassert( 13511 , "document to insert can't have $ fields" , e.fieldName()[0] != '$' );
+        }
+    }
+
+    bool DataFileMgr::canInsertBatch(const char *ns) {
+        if ( !NamespaceString::normal( ns ) || !isValidNS( ns ) || strstr( ns, "system." ) )
+            return false;
+        NamespaceDetails *d = nsdetails( ns );
+        return d == 0 || ( !d->isCapped() && !d->indexBuildInProgress );
+    }
+
+    namespace {
+
+        /** a document of an insertBatch() chunk, with all that is computed before any write */
+        struct BatchDoc {
+            size_t i;                 // position in objs
+            int lenWHdr;
+            vector<BSONObjSet> keys;  // one set per index
+            DiskLoc loc;
+        };
+
+        /** index keys in the order the btree holds them */
+        class BatchKeyCmp {
+        public:
+            BatchKeyCmp( const Ordering& o ) : _o( o ) { }
+            bool operator()( const pair<BSONObj,DiskLoc>& l, const pair<BSONObj,DiskLoc>& r ) const {
+                int x = l.first.woCompare( r.first, _o, false );
+                return x < 0 || ( x == 0 && l.second < r.second );
+            }
+        private:
+            Ordering _o;
+        };
+
+        /* a chunk is written and indexed as a unit and can't straddle a group commit, so keep it
+           well under dur's UncommittedBytesLimit */
+        const size_t BatchMaxDocs = 1000;
+        const int BatchMaxBytes = 8 * 1024 * 1024;
+
+        void addToStats( NamespaceDetails *d, long long dataSize, long long nRecords ) {
+            NamespaceDetails::Stats *s = getDur().writing(&d->stats);
+            s->datasize += dataSize;
+            s->nrecords += nRecords;
+        }
+
+    }
+
+    void DataFileMgr::insertBatch(const char *ns, vector<BSONObj>& objs, bool keepGoing, size_t& nDone) {
+        verify( canInsertBatch( ns ) );
+        const bool mayAddId = !str::equals( nsToDatabase( ns ).c_str() , "local" );
+
+        int errCode = 0;
+        string errMsg;
+        size_t errAt = 0;
+        bool stop = false;
+
+        nDone = 0;
+        size_t next = 0;
+        while ( next < objs.size() && !stop ) {
+            NamespaceDetails *d = nsdetails( ns );
+            if ( d == 0 )
+                d = insert_newNamespace( ns, objs[next].objsize(), false );
+            const int nIndexes = d->nIndexes;
+
+            // Step 1: check the documents and compute their keys.  Nothing is written yet, so a
+            // document that fails is simply left out of the chunk.
+            vector<BatchDoc> docs;
+            vector<BSONObjSet> uniqueKeys( nIndexes ); // keys accepted so far, for unique indexes
+            int bytes = 0;
+            for ( ; next < objs.size() && docs.size() < BatchMaxDocs && bytes < BatchMaxBytes; next++ ) {
+                docs.push_back( BatchDoc() );
+                BatchDoc& doc = docs.back();
+                doc.i = next;
+                BSONObj& o = objs[next];
+                try {
+                    checkUserInsert( o );
+                    BSONElement idField = o.getField( "_id" );
+                    uassert( 10099 ,  "_id cannot be an array", idField.type() != Array );
+                    if ( idField.eoo() && mayAddId && d->haveIdIndex() ) {
+                        OID oid;
+                        oid.init();
+                        BSONObjBuilder b( o.objsize() + 32 );
+                        b.append( "_id", oid );
+                        b.appendElements( o );
+                        o = b.obj();
+                    }
+                    BSONElementManipulator::lookForTimestamps( o );
+
+                    doc.lenWHdr = d->getRecordAllocationSize( o.objsize() + Record::HeaderSize );
+                    doc.keys.resize( nIndexes );
+                    for ( int j = 0; j < nIndexes; j++ ) {
+                        IndexDetails& idx = d->idx( j );
+                        idx.getKeysFromObject( o, doc.keys[j] );
+                        if ( !idx.unique() || ignoreUniqueIndex( idx ) )
+                            continue;
+                        IndexInterface& ii = idx.idxInterface();
+                        for ( BSONObjSet::const_iterator k = doc.keys[j].begin(); k != doc.keys[j].end(); ++k ) {
+                            if ( uniqueKeys[j].count( *k ) || !ii.findSingle( idx, idx.head, *k ).isNull() ) {
+                                uasserted( ASSERT_ID_DUPKEY, str::stream() << "E11000 duplicate key error "
+                                           << "index: " << idx.indexNamespace() << "  "
+                                           << "dup key: " << k->toString() );
+                            }
+                        }
+                    }
+                }
+                catch ( UserException& e ) {
+                    docs.pop_back();
+                    errCode = e.getCode();
+                    errMsg = e.what();
+                    errAt = next;
+                    if ( !keepGoing ) {
+                        stop = true;
+                        break;
+                    }
+                    continue;
+                }
+
+                for ( int j = 0; j < nIndexes; j++ ) {
+                    if ( d->idx( j ).unique() )
+                        uniqueKeys[j].insert( doc.keys[j].begin(), doc.keys[j].end() );
+                }
+                bytes += doc.lenWHdr;
+            }
+
+            if ( docs.empty() )
+                continue;
+
+            // Step 2: write all the records, then add each index's keys in key order.
+            long long dataSize = 0;
+            long long nRecords = 0;
+            bool statsAdded = false;
+            try {
+                for ( vector<BatchDoc>::iterator i = docs.begin(); i != docs.end(); ++i ) {
+                    const BSONObj& o = objs[i->i];
+                    DiskLoc loc = allocateSpaceForANewRecord( ns, d, i->lenWHdr, false );
+                    verify( !loc.isNull() );
+                    Record *r = loc.rec();
+                    verify( r->lengthWithHeaders() >= i->lenWHdr );
+                    r = (Record*) getDur().writingPtr( r, i->lenWHdr );
+                    memcpy( r->data(), o.objdata(), o.objsize() );
+                    addRecordToRecListInExtent( r, loc );
+                    i->loc = loc;
+                    dataSize += r->netLength();
+                    nRecords++;
+                    d->paddingFits();
+                }
+                // durability: one write intent for the whole chunk's stats
+                addToStats( d, dataSize, nRecords );
+                statsAdded = true;
+
+                vector< pair<BSONObj,DiskLoc> > keys;
+                for ( int j = 0; j < nIndexes; j++ ) {
+                    IndexDetails& idx = d->idx( j );
+                    keys.clear();
+                    bool multikey = false;
+                    for ( vector<BatchDoc>::const_iterator i = docs.begin(); i != docs.end(); ++i ) {
+                        const BSONObjSet& docKeys = i->keys[j];
+                        if ( docKeys.size() > 1 )
+                            multikey = true;
+                        for ( BSONObjSet::const_iterator k = docKeys.begin(); k != docKeys.end(); ++k )
+                            keys.push_back( make_pair( *k, i->loc ) );
+                    }
+                    if ( multikey )
+                        d->setIndexIsMultikey( ns, j );
+
+                    Ordering ordering = Ordering::make( idx.keyPattern() );
+                    std::sort( keys.begin(), keys.end(), BatchKeyCmp( ordering ) );
+                    bool dupsAllowed = !idx.unique() || ignoreUniqueIndex( idx );
+                    IndexInterface& ii = idx.idxInterface();
+                    for ( vector< pair<BSONObj,DiskLoc> >::const_iterator k = keys.begin(); k != keys.end(); ++k )
+                        ii.bt_insert( idx.head, k->second, k->first, ordering, dupsAllowed, idx );
+                }
+            }
+            catch ( ... ) {
+                // not expected, as the keys were checked above; back out the whole chunk
+                if ( !statsAdded )
+                    addToStats( d, dataSize, nRecords );
+                for ( vector<BatchDoc>::const_iterator i = docs.begin(); i != docs.end(); ++i ) {
+                    if ( i->loc.isNull() )
+                        continue;
+                    try {
+                        unindexRecord( d, i->loc.rec(), i->loc, true );
+                    }
+                    catch ( ... ) {
+                        LOG(3) << "unindex fails on rollback of batch insert" << endl;
+                    }
+                    _deleteRecord( d, ns, i->loc.rec(), i->loc );
+                }
+                nDone = docs.front().i;
+                throw;
+            }
+
+            NamespaceDetailsTransient::get( ns ).notifyOfWriteOp();
+            for ( vector<BatchDoc>::const_iterator i = docs.begin(); i != docs.end(); ++i )
+                logOp( "i", ns, objs[i->i] );
+            nDone = next;
+            getDur().commitIfNeeded();
+        }
+
+        if ( errCode && ( !keepGoing || errAt == objs.size() - 1 ) ) {
+            nDone = errAt;
+            uasserted( errCode, errMsg );
+        }
+        nDone = objs.size();
+    }
+
     /* special version of insert for transaction logging -- streamlined a bit.
        assumes ns is capped and no indexes
     */
@@ -62,6 +62,9 @@ namespace mongo {
 
     bool isValidNS( const StringData& ns );
 
+    /** uasserts that js may be inserted by a client: size limit, no top level $ fields */
+    void checkUserInsert( const BSONObj& js );
+
     /*---------------------------------------------------------------------*/
 
     class MongoDataFile {
@@ -163,6 +166,28 @@ namespace mongo {
                        bool god = false,
                        bool mayAddIndex = true,
                        bool* addedID = 0);
+
+        /**
+         * @return true if insertBatch() can be used for ns: an ordinary (non system, non
+         *     capped) collection with no index build in progress.  ns need not exist yet.
+         */
+        static bool canInsertBatch(const char *ns);
+
+        /**
+         * Insert and logOp the user documents @param objs into ns, with the same outcome as
+         * calling checkUserInsert() / insertWithObjMod() / logOp() on each in turn, but with
+         * index maintenance amortized over the batch: all records are written first, then
+         * the keys for each index are sorted and added in key order, so consecutive btree
+         * inserts touch neighbouring (and mostly the rightmost) buckets.
+         * A document that can't be inserted (invalid, duplicate key on a unique index, ...) is
+         * skipped; unless @param keepGoing, no later document is inserted either.  Its error
+         * is rethrown once the documents before it are in, if keepGoing is false or it was the
+         * last document.
+         * @param objs in/out: an _id is added to documents lacking one
+         * @param nDone out: number of documents handled before the error that is thrown, or
+         *     objs.size() if nothing is thrown.  For the insert opcounter.
+         */
+        void insertBatch(const char *ns, vector<BSONObj>& objs, bool keepGoing, size_t& nDone);
         static shared_ptr<Cursor> findAll(const char *ns, const DiskLoc &startLoc = DiskLoc());
 
         /* special version of insert for transaction logging -- streamlined a bit.
@@ -309,6 +334,20 @@ namespace mongo {
         static void appendStats( BSONObjBuilder& b );
 
         static void appendWorkingSetInfo( BSONObjBuilder& b );
+
+        /** the number of the page data is on, as likelyInPhysicalMemory() tracks them */
+        static size_t trackedPageOf( const void* data ) { return (size_t)data >> 12; }
+        static const int TrackedPageSize = 1 << 12;
+
+        /**
+         * Gets the pages accessed recently, as far as the tracking for likelyInPhysicalMemory()
+         * remembers, which is at most 10 slices of at most 90 seconds each.  A page accessed
+         * again can be noted in an older slice only, so short windows undercount.
+         * @param windowSecs how far back to look, rounded up to slices; <= 0 for all of it
+         * @param pages OUT sorted numbers of the pages, see trackedPageOf()
+         * @return how many seconds back pages were looked for, at most
+         */
+        static int touchedPages( int windowSecs , vector<size_t>* pages );
     private:
         
         int _netLength() const { return _lengthWithHeaders - HeaderSize; }
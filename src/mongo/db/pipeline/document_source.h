@@ -318,6 +318,18 @@ namespace mongo {
             const ShardOutput& shardOutput,
             const intrusive_ptr<ExpressionContext>& pExpCtx);
 
+        /**
+          Get one source per shard that returned results, instead of
+          iterating over the concatenation of all of them.  Used by
+          consumers that merge the shards' outputs, such as a $sort whose
+          input has already been sorted on each shard.
+
+          Must be called before this source is iterated.
+
+          @param pSources receives the non-empty per shard sources
+         */
+        void getShardSources(vector<intrusive_ptr<DocumentSource> > *pSources);
+
     protected:
         // virtuals from DocumentSource
         virtual void sourceToBson(BSONObjBuilder *pBuilder, bool explain) const;
@@ -335,6 +347,13 @@ namespace mongo {
          */
         void getNextDocument();
 
+        /**
+          Check that a shard's reply is a successful aggregation result.
+
+          @returns the shard's result array
+         */
+        static BSONElement getResultArray(const ShardOutput::const_iterator& shardResult);
+
         bool newSource; // set to true for the first item of a new source
         intrusive_ptr<DocumentSourceBsonArray> pBsonSource;
         intrusive_ptr<Document> pCurrent;
@@ -457,6 +476,13 @@ namespace mongo {
 
         bool canUseCoveredIndex();
 
+        /*
+          Build the current Document straight from the index key, skipping
+          the intermediate BSONObj the key would otherwise be hydrated into.
+         */
+        intrusive_ptr<Document> documentFromKey(
+            const Projection::KeyOnly &keyFields, const BSONObj &key) const;
+
         /*
           Yield the cursor sometimes.
 
@@ -859,11 +885,10 @@ namespace mongo {
             const intrusive_ptr<ExpressionContext> &pExpCtx);
 
         // Virtuals for SplittableDocumentSource
-        // All work for sort is done in router currently
-        // TODO: do partial sorts on the shards then merge in the router
-        //       Not currently possible due to DocumentSource's cursor-like interface
-        virtual intrusive_ptr<DocumentSource> getShardSource() { return NULL; }
-        virtual intrusive_ptr<DocumentSource> getRouterSource() { return this; }
+        // Each shard sorts its own output; the router merges the sorted
+        // streams rather than sorting everything again.
+        virtual intrusive_ptr<DocumentSource> getShardSource() { return this; }
+        virtual intrusive_ptr<DocumentSource> getRouterSource();
 
         /**
           Add sort key field.
@@ -919,6 +944,30 @@ namespace mongo {
         void populate();
         bool populated;
 
+        /*
+          If the input is the output of shards that each already sorted
+          their documents with this same key, k-way merge the shards'
+          streams instead of buffering and sorting all of them.  This is
+          only set on the router half of a split $sort.
+         */
+        bool mergePresorted;
+
+        /*
+          Set up the merge of the per shard streams.
+          @returns false if the input doesn't come from the shards, in
+            which case a regular sort must be done
+         */
+        bool populateMerge();
+
+        /*
+          While merging: the shard streams, each one's current document, and
+          a min-heap of the indexes of the streams that aren't exhausted.
+         */
+        bool merging;
+        vector<intrusive_ptr<DocumentSource> > mergeSources;
+        vector<intrusive_ptr<Document> > mergeCurrent;
+        vector<size_t> mergeHeap;
+
         /* these two parallel each other */
         typedef vector<intrusive_ptr<ExpressionFieldPath> > SortPaths;
         SortPaths vSortKey;
@@ -955,6 +1004,28 @@ namespace mongo {
             DocumentSourceSort *pSort;
         };
 
+        /*
+          Orders merge stream indexes for a min-heap on their current
+          documents; ties go to the lower index to keep the merge stable.
+         */
+        class MergeComparator {
+        public:
+            bool operator()(size_t lhs, size_t rhs) const {
+                int cmp = pSort->compare(pSort->mergeCurrent[lhs],
+                                         pSort->mergeCurrent[rhs]);
+                if (cmp)
+                    return cmp > 0;
+                return lhs > rhs;
+            }
+
+            inline MergeComparator(DocumentSourceSort *pS):
+                pSort(pS) {
+            }
+
+        private:
+            DocumentSourceSort *pSort;
+        };
+
         typedef vector<intrusive_ptr<Document> > VectorType;
         VectorType documents;
 
@@ -80,6 +80,40 @@ namespace mongo {
         return pSource;
     }
 
+    BSONElement DocumentSourceCommandShards::getResultArray(
+        const ShardOutput::const_iterator& shardResult) {
+        /* grab the next command result */
+        const BSONObj& resultObj = shardResult->second;
+
+        uassert(16390, str::stream() << "sharded pipeline failed on shard " <<
+                                    shardResult->first.getName() << ": " <<
+                                    resultObj.toString(),
+                resultObj["ok"].trueValue());
+
+        /* grab the result array out of the shard server's response */
+        BSONElement resultArray = resultObj["result"];
+        massert(16391, str::stream() << "no result array? shard:" <<
+                                    shardResult->first.getName() << ": " <<
+                                    resultObj.toString(),
+                resultArray.type() == Array);
+
+        return resultArray;
+    }
+
+    void DocumentSourceCommandShards::getShardSources(
+        vector<intrusive_ptr<DocumentSource> > *pSources) {
+        verify(!pCurrent.get() && !pBsonSource.get());
+
+        for(; iterator != listEnd; ++iterator) {
+            BSONElement resultArray = getResultArray(iterator);
+            if (resultArray.embeddedObject().isEmpty())
+                continue;
+
+            pSources->push_back(
+                DocumentSourceBsonArray::create(&resultArray, pExpCtx));
+        }
+    }
+
     void DocumentSourceCommandShards::getNextDocument() {
         while(true) {
             if (!pBsonSource.get()) {
@@ -89,20 +123,7 @@ namespace mongo {
                     return;
                 }
 
-                /* grab the next command result */
-                BSONObj resultObj = iterator->second;
-
-                uassert(16390, str::stream() << "sharded pipeline failed on shard " <<
-                                            iterator->first.getName() << ": " <<
-                                            resultObj.toString(),
-                        resultObj["ok"].trueValue());
-
-                /* grab the result array out of the shard server's response */
-                BSONElement resultArray = resultObj["result"];
-                massert(16391, str::stream() << "no result array? shard:" <<
-                                            iterator->first.getName() << ": " <<
-                                            resultObj.toString(),
-                        resultArray.type() == Array);
+                BSONElement resultArray = getResultArray(iterator);
 
                 // done with error checking, don't need the shard name anymore
                 ++iterator;
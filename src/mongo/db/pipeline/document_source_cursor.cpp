@@ -116,13 +116,13 @@ namespace mongo {
                 continue;
 
             // grab the matching document
-            BSONObj documentObj;
             if (canUseCoveredIndex()) {
                 // Can't have a Chunk Manager if we are here
-                documentObj = cursor()->c()->keyFieldsOnly()->hydrate(cursor()->currKey());
+                pCurrent = documentFromKey(*cursor()->c()->keyFieldsOnly(),
+                                           cursor()->currKey());
             }
             else {
-                documentObj = cursor()->current();
+                BSONObj documentObj = cursor()->current();
 
                 // check to see if this is a new object we don't own yet
                 // because of a chunk migration
@@ -132,9 +132,9 @@ namespace mongo {
                 if (_projection) {
                     documentObj = _projection->transform(documentObj);
                 }
-            }
 
-            pCurrent = Document::createFromBsonObj(&documentObj);
+                pCurrent = Document::createFromBsonObj(&documentObj);
+            }
 
             cursor()->advance();
             return;
@@ -146,6 +146,24 @@ namespace mongo {
         pCurrent.reset();
     }
 
+    intrusive_ptr<Document> DocumentSourceCursor::documentFromKey(
+        const Projection::KeyOnly &keyFields, const BSONObj &key) const {
+        intrusive_ptr<Document> pDocument(Document::create(keyFields.nFields()));
+
+        /* Values copy what they need, so the key may go away after this */
+        BSONObjIterator it(key);
+        for(unsigned i = 0; it.more(); ++i) {
+            verify(i < keyFields.nFields());
+            BSONElement keyElement(it.next());
+            if (keyFields.includes(i)) {
+                pDocument->addField(keyFields.fieldName(i),
+                                    Value::createFromBsonElement(&keyElement));
+            }
+        }
+
+        return pDocument;
+    }
+
     void DocumentSourceCursor::setSource(DocumentSource *pSource) {
         /* this doesn't take a source */
         verify(false);
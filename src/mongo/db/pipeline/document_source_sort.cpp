@@ -40,6 +40,9 @@ namespace mongo {
         if (!populated)
             populate();
 
+        if (merging)
+            return mergeHeap.empty();
+
         return (docIterator == documents.end());
     }
 
@@ -49,6 +52,31 @@ namespace mongo {
         if (!populated)
             populate();
 
+        if (merging) {
+            verify(!mergeHeap.empty());
+
+            /* move the stream we just returned from past its document */
+            MergeComparator comparator(this);
+            pop_heap(mergeHeap.begin(), mergeHeap.end(), comparator);
+            const size_t index = mergeHeap.back();
+            if (mergeSources[index]->advance()) {
+                mergeCurrent[index] = mergeSources[index]->getCurrent();
+                push_heap(mergeHeap.begin(), mergeHeap.end(), comparator);
+            }
+            else {
+                mergeHeap.pop_back();
+                mergeSources[index].reset();
+                mergeCurrent[index].reset();
+            }
+
+            if (mergeHeap.empty()) {
+                pCurrent.reset();
+                return false;
+            }
+            pCurrent = mergeCurrent[mergeHeap.front()];
+            return true;
+        }
+
         verify(docIterator != documents.end());
 
         ++docIterator;
@@ -85,7 +113,17 @@ namespace mongo {
     DocumentSourceSort::DocumentSourceSort(
         const intrusive_ptr<ExpressionContext> &pExpCtx):
         SplittableDocumentSource(pExpCtx),
-        populated(false) {
+        populated(false),
+        mergePresorted(false),
+        merging(false) {
+    }
+
+    intrusive_ptr<DocumentSource> DocumentSourceSort::getRouterSource() {
+        intrusive_ptr<DocumentSourceSort> pMerge(DocumentSourceSort::create(pExpCtx));
+        pMerge->vSortKey = vSortKey;
+        pMerge->vAscending = vAscending;
+        pMerge->mergePresorted = true;
+        return pMerge;
     }
 
     void DocumentSourceSort::addKey(const string &fieldPath, bool ascending) {
@@ -154,10 +192,43 @@ namespace mongo {
         return pSort;
     }
 
+    bool DocumentSourceSort::populateMerge() {
+        DocumentSourceCommandShards *pShards =
+            dynamic_cast<DocumentSourceCommandShards *>(pSource);
+        if (!pShards)
+            return false;
+
+        pShards->getShardSources(&mergeSources);
+
+        /* start with each shard's first document */
+        mergeCurrent.resize(mergeSources.size());
+        for(size_t i = 0; i < mergeSources.size(); ++i) {
+            if (mergeSources[i]->eof())
+                continue;
+
+            mergeCurrent[i] = mergeSources[i]->getCurrent();
+            mergeHeap.push_back(i);
+        }
+
+        MergeComparator comparator(this);
+        make_heap(mergeHeap.begin(), mergeHeap.end(), comparator);
+
+        if (!mergeHeap.empty())
+            pCurrent = mergeCurrent[mergeHeap.front()];
+
+        merging = true;
+        return true;
+    }
+
     void DocumentSourceSort::populate() {
         /* make sure we've got a sort key */
         verify(vSortKey.size());
 
+        if (mergePresorted && populateMerge()) {
+            populated = true;
+            return;
+        }
+
         /* track and warn about how much physical memory has been used */
         DocMemMonitor dmm(this);
 
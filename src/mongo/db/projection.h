@@ -45,6 +45,11 @@ namespace mongo {
             void addNo() { _add( false , "" ); }
             void addYes( const string& name ) { _add( true , name ); }
 
+            /** the number of fields in the key, whether or not they are in the output */
+            unsigned nFields() const { return _include.size(); }
+            bool includes( unsigned i ) const { return _include[i]; }
+            const string& fieldName( unsigned i ) const { return _names[i]; }
+
         private:
 
             void _add( bool b , const string& name ) {
@@ -134,10 +134,13 @@ namespace mongo {
         _index = &_d->idx(_idxNo);
 
         // If the parsing or index indicates this is a special query, don't continue the processing
-        if ( _special.size() ||
-            ( _index->getSpec().getType() &&
-             _index->getSpec().getType()->suitability( _originalQuery, _order ) != USELESS ) ) {
+        IndexSuitability typeSuitability = USELESS;
+        if ( _index->getSpec().getType() ) {
+            typeSuitability = _index->getSpec().getType()->suitability( _originalQuery, _order );
+        }
+        if ( _special.size() || typeSuitability != USELESS ) {
 
+            bool specialQuery = !_special.empty();
             _type  = _index->getSpec().getType();
             if( !_special.size() ) _special = _index->getSpec().getType()->getPlugin()->getName();
 
@@ -145,6 +148,13 @@ namespace mongo {
             // hopefully safe to use original query in these contexts;
             // don't think we can mix special with $or clause separation yet
             _scanAndOrderRequired = _type->scanAndOrderRequired( _originalQuery , _order );
+
+            // An index type that fully answers an ordinary query (e.g. a hashed index serving
+            // point lookups) competes as an optimal plan rather than only being used when no
+            // btree plan is available.
+            if ( !specialQuery && typeSuitability == OPTIMAL && !_scanAndOrderRequired ) {
+                _utility = Optimal;
+            }
             return;
         }
 
@@ -253,7 +263,15 @@ doneCheckOrder:
             _utility = Disallowed;
         }
 
-        if ( _parsedQuery && _parsedQuery->getFields() && !_d->isMultikey( _idxNo ) ) { // Does not check modifiedKeys()
+        // A partial index lacks the documents outside its filter, so it may only answer queries
+        // that rule those documents out.
+        if ( idxSpec.isPartial() && !idxSpec.filterImpliedBy( _frsMulti ) ) {
+            _utility = Disallowed;
+        }
+
+        // Keys of plugin index types (eg hashed values) can't stand in for document fields.
+        if ( _parsedQuery && _parsedQuery->getFields() && !_d->isMultikey( _idxNo ) &&
+             !idxSpec.getType() ) { // Does not check modifiedKeys()
             _keyFieldsOnly.reset( _parsedQuery->getFields()->checkKey( _index->keyPattern() ) );
         }
     }
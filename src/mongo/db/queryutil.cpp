@@ -18,6 +18,8 @@
 #include "pch.h"
 
 #include "mongo/db/queryutil.h"
+
+#include "mongo/db/hasher.h"
 #include "pdfile.h"
 #include "../util/startup_test.h"
 #include "dbmessage.h"
@@ -160,6 +162,58 @@ namespace mongo {
     }
 
 
+    /** Helper class for assembling a union of FieldRange objects. */
+    class RangeUnionBuilder : boost::noncopyable {
+    public:
+        RangeUnionBuilder() : _initial( true ) {}
+        /** @param next: Supply next ordered interval, ordered by _lower FieldBound. */
+        void nextOrderedInterval( const FieldInterval &next ) {
+            if ( _initial ) {
+                _tail = next;
+                _initial = false;
+                return;
+            }
+            if ( !handleDisjoint( next ) ) {
+                handleExtend( next );
+            }
+        }
+        void done() {
+            if ( !_initial ) {
+                _unionIntervals.push_back( _tail );
+            }
+        }
+        const vector<FieldInterval> &unionIntervals() const { return _unionIntervals; }
+    private:
+        /** If _tail and next are disjoint, next becomes the new _tail. */
+        bool handleDisjoint( const FieldInterval &next ) {
+            int cmp = _tail._upper._bound.woCompare( next._lower._bound, false );
+            if ( ( cmp < 0 ) ||
+                ( cmp == 0 && !_tail._upper._inclusive && !next._lower._inclusive ) ) {
+                _unionIntervals.push_back( _tail );
+                _tail = next;
+                return true;
+            }
+            return false;
+        }
+        /** Extend _tail to upper bound of next if necessary. */
+        void handleExtend( const FieldInterval &next ) {
+            int cmp = _tail._upper._bound.woCompare( next._upper._bound, false );
+            if ( ( cmp < 0 ) ||
+                ( cmp == 0 && !_tail._upper._inclusive && next._upper._inclusive ) ) {
+                _tail._upper = next._upper;
+            }            
+        }
+        bool _initial;
+        FieldInterval _tail;
+        vector<FieldInterval> _unionIntervals;
+    };
+
+    /** @return true if a's lower bound sorts before b's, an inclusive bound first on a tie. */
+    static bool lowerBoundLess( const FieldInterval &a, const FieldInterval &b ) {
+        int cmp = a._lower._bound.woCompare( b._lower._bound, false );
+        return cmp < 0 || ( cmp == 0 && a._lower._inclusive && !b._lower._inclusive );
+    }
+
     FieldRange::FieldRange( const BSONElement &e, bool isNot, bool optimize ) :
     _exactMatchRepresentation() {
         int op = e.getGtLtOp();
@@ -206,8 +260,21 @@ namespace mongo {
             for( set<BSONElement,element_lt>::const_iterator i = vals.begin(); i != vals.end(); ++i )
                 _intervals.push_back( FieldInterval(*i) );
 
-            for( vector<FieldRange>::const_iterator i = regexes.begin(); i != regexes.end(); ++i )
-                *this |= *i;
+            if ( !regexes.empty() ) {
+                // Union the regex ranges with the points in a single ordered pass rather than one
+                // pass per regex, as $in lists of many prefix regexes (eg s2 coverings) are common.
+                vector<FieldInterval> intervals( _intervals );
+                for( vector<FieldRange>::const_iterator i = regexes.begin(); i != regexes.end(); ++i ) {
+                    intervals.insert( intervals.end(), i->_intervals.begin(), i->_intervals.end() );
+                    _objData.insert( _objData.end(), i->_objData.begin(), i->_objData.end() );
+                }
+                sort( intervals.begin(), intervals.end(), lowerBoundLess );
+                RangeUnionBuilder b;
+                for( vector<FieldInterval>::const_iterator i = intervals.begin(); i != intervals.end(); ++i )
+                    b.nextOrderedInterval( *i );
+                b.done();
+                _intervals = b.unionIntervals();
+            }
 
             return;
         }
@@ -585,52 +652,6 @@ namespace mongo {
         return *this;
     }
 
-    /** Helper class for assembling a union of FieldRange objects. */
-    class RangeUnionBuilder : boost::noncopyable {
-    public:
-        RangeUnionBuilder() : _initial( true ) {}
-        /** @param next: Supply next ordered interval, ordered by _lower FieldBound. */
-        void nextOrderedInterval( const FieldInterval &next ) {
-            if ( _initial ) {
-                _tail = next;
-                _initial = false;
-                return;
-            }
-            if ( !handleDisjoint( next ) ) {
-                handleExtend( next );
-            }
-        }
-        void done() {
-            if ( !_initial ) {
-                _unionIntervals.push_back( _tail );
-            }
-        }
-        const vector<FieldInterval> &unionIntervals() const { return _unionIntervals; }
-    private:
-        /** If _tail and next are disjoint, next becomes the new _tail. */
-        bool handleDisjoint( const FieldInterval &next ) {
-            int cmp = _tail._upper._bound.woCompare( next._lower._bound, false );
-            if ( ( cmp < 0 ) ||
-                ( cmp == 0 && !_tail._upper._inclusive && !next._lower._inclusive ) ) {
-                _unionIntervals.push_back( _tail );
-                _tail = next;
-                return true;
-            }
-            return false;
-        }
-        /** Extend _tail to upper bound of next if necessary. */
-        void handleExtend( const FieldInterval &next ) {
-            int cmp = _tail._upper._bound.woCompare( next._upper._bound, false );
-            if ( ( cmp < 0 ) ||
-                ( cmp == 0 && !_tail._upper._inclusive && next._upper._inclusive ) ) {
-                _tail._upper = next._upper;
-            }            
-        }
-        bool _initial;
-        FieldInterval _tail;
-        vector<FieldInterval> _unionIntervals;
-    };
-
     const FieldRange &FieldRange::operator|=( const FieldRange &other ) {
         RangeUnionBuilder b;
         vector<FieldInterval>::const_iterator i = _intervals.begin();
@@ -1195,6 +1216,29 @@ namespace mongo {
                 }
             }
 
+            // Keys of a hashed field hold the hashes of the field's values, so only point
+            // intervals can be mapped onto the index; anything else must scan the whole field.
+            scoped_ptr<FieldRange> hashedRange;
+            if ( e.type() == String && str::equals( e.valuestr(), "hashed" ) ) {
+                if ( range->isPointIntervalSet() ) {
+                    BSONArrayBuilder hashes;
+                    HashSeed seed = _indexSpec.info[ "seed" ].numberInt();
+                    for( vector<FieldInterval>::const_iterator j = range->intervals().begin();
+                         j != range->intervals().end(); ++j ) {
+                        hashes.append( BSONElementHasher::hash64( j->_lower._bound, seed ) );
+                    }
+                    _queries.push_back( BSON( "$in" << hashes.arr() ) );
+                    hashedRange.reset( new FieldRange( _queries.back().firstElement(), false,
+                                                       true ) );
+                    range = hashedRange.get();
+                    _hasAllIndexedRanges = false;
+                }
+                else if ( !range->universal() ) {
+                    range = &frs.universalRange();
+                    _hasAllIndexedRanges = false;
+                }
+            }
+
             int number = (int) e.number(); // returns 0.0 if not numeric
             bool forward = ( ( number >= 0 ? 1 : -1 ) * ( direction >= 0 ? 1 : -1 ) > 0 );
             if ( forward ) {
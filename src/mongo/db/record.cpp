@@ -219,8 +219,10 @@ namespace mongo {
             /**
              * @param pages OUT adds each page to the set
              * @param mySlices temporary space for copy
+             * @param numSlices how many slices to look at, newest first
              */
-            void addPages( unordered_set<size_t>* pages, Slice* mySlices ) {
+            void addPages( unordered_set<size_t>* pages, Slice* mySlices, int numSlices = NumSlices ) {
+                int curSlice;
                 {
                     // by doing this, we're in the lock only about half as long as the naive way
                     // that's measure with a small data set
@@ -228,9 +230,10 @@ namespace mongo {
                     // so this way the time in lock should be totally constant
                     SimpleMutex::scoped_lock lk( _lock );
                     memcpy( mySlices, _slices, NumSlices * sizeof(Slice) );
+                    curSlice = _curSlice;
                 }
-                for ( int i = 0; i < NumSlices; i++ ) {
-                    mySlices[i].addPages( pages );
+                for ( int i = 0; i < numSlices; i++ ) {
+                    mySlices[ ( curSlice + NumSlices - i ) % NumSlices ].addPages( pages );
                 }
             }
         private:
@@ -360,6 +363,30 @@ namespace mongo {
             b.appendNumber( "computationTimeMicros", static_cast<long long>(t.micros()) );
 
         }
+
+        /**
+         * slices rotate after at most RotateTimeSecs, sooner if they fill up, so a window of
+         * slices covers at most that many seconds each
+         */
+        int slicesFor( int windowSecs ) {
+            if ( windowSecs <= 0 || windowSecs >= NumSlices * RotateTimeSecs )
+                return NumSlices;
+            return ( windowSecs + RotateTimeSecs - 1 ) / RotateTimeSecs;
+        }
+
+        int touchedPages( int windowSecs , vector<size_t>* pages ) {
+            int numSlices = slicesFor( windowSecs );
+
+            boost::scoped_array<Slice> mySlices( new Slice[NumSlices] );
+            unordered_set<size_t> touched;
+            for ( int i = 0; i < BigHashSize; i++ ) {
+                rolling[i].addPages( &touched, mySlices.get(), numSlices );
+            }
+
+            pages->assign( touched.begin(), touched.end() );
+            std::sort( pages->begin(), pages->end() );
+            return numSlices * RotateTimeSecs;
+        }
         
     }
 
@@ -416,6 +443,10 @@ namespace mongo {
         ps::appendWorkingSetInfo( b );
     }
 
+    int Record::touchedPages( int windowSecs , vector<size_t>* pages ) {
+        return ps::touchedPages( windowSecs , pages );
+    }
+
     bool Record::blockCheckSupported() { 
         return ProcessInfo::blockCheckSupported();
     }
@@ -453,7 +484,7 @@ namespace mongo {
         if ( ! MemoryTrackingEnabled )
             return true;
 
-        const size_t page = (size_t)data >> 12;
+        const size_t page = trackedPageOf( data );
         const size_t region = page >> 6;
         const size_t offset = page & 0x3f;
 
@@ -482,7 +513,7 @@ namespace mongo {
     Record* Record::accessed() {
         const bool seen = ps::PointerTable::seen( ps::PointerTable::getData(), reinterpret_cast<size_t>(_data));
         if (!seen){
-            const size_t page = (size_t)_data >> 12;
+            const size_t page = trackedPageOf( _data );
             const size_t region = page >> 6;
             const size_t offset = page & 0x3f;        
             ps::rolling[ps::bigHash(region)].access( region , offset , true );
@@ -1441,6 +1441,7 @@ namespace mongo {
     void replSlaveThread() {
         sleepsecs(1);
         Client::initThread("replslave");
+        Lock::scheduleThreadAs( Lock::ReplApply );
 
         {
             Lock::GlobalWrite lk;
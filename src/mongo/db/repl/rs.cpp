@@ -421,8 +421,8 @@ namespace mongo {
         _maintenanceMode(0),
         mgr(0),
         ghost(0),
-        _writerPool(replWriterThreadCount),
-        _prefetcherPool(replPrefetcherThreadCount),
+        // prefetching and writing take turns, so they can share the threads
+        _replExecutor(std::max(replWriterThreadCount, replPrefetcherThreadCount), "repl worker"),
         oplogVersion(0),
         _indexPrefetchConfig(PREFETCH_ALL) {
     }
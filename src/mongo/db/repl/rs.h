@@ -29,7 +29,7 @@
 #include "mongo/db/repl/rs_sync.h"
 #include "mongo/util/concurrency/list.h"
 #include "mongo/util/concurrency/msg.h"
-#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/task_executor.h"
 #include "mongo/util/concurrency/value.h"
 #include "mongo/util/net/hostandport.h"
 
@@ -514,10 +514,8 @@ namespace mongo {
 
         // keep a list of hosts that we've tried recently that didn't work
         map<string,time_t> _veto;
-        // persistent pool of worker threads for writing ops to the databases
-        threadpool::ThreadPool _writerPool;
-        // persistent pool of worker threads for prefetching
-        threadpool::ThreadPool _prefetcherPool;
+        // persistent worker threads for prefetching ops and writing them to the databases
+        TaskExecutor _replExecutor;
 
     public:
         // Allow index prefetching to be turned on/off
@@ -534,8 +532,7 @@ namespace mongo {
             
         static const int replWriterThreadCount;
         static const int replPrefetcherThreadCount;
-        threadpool::ThreadPool& getPrefetchPool() { return _prefetcherPool; }
-        threadpool::ThreadPool& getWriterPool() { return _writerPool; }
+        TaskExecutor& getReplExecutor() { return _replExecutor; }
 
 
         const ReplSetConfig::MemberCfg& myConfig() const { return _config; }
@@ -582,8 +579,7 @@ namespace mongo {
         void summarizeAsHtml(stringstream& ss) const { _summarizeAsHtml(ss); }
         void summarizeStatus(BSONObjBuilder& b) const  { _summarizeStatus(b); }
         void fillIsMaster(BSONObjBuilder& b) { _fillIsMaster(b); }
-        threadpool::ThreadPool& getPrefetchPool() { return ReplSetImpl::getPrefetchPool(); }
-        threadpool::ThreadPool& getWriterPool() { return ReplSetImpl::getWriterPool(); }
+        TaskExecutor& getReplExecutor() { return ReplSetImpl::getReplExecutor(); }
 
         /**
          * We have a new config (reconfig) - apply it.
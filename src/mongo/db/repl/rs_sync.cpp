@@ -87,28 +87,21 @@ namespace replset {
         return ok;
     }
 
-    void initializePrefetchThread() {
-        if (!ClientBasic::getCurrent()) {
-            Client::initThread("repl prefetch worker");
-            replLocalAuth();
-        }
-    }
-
-    static AtomicUInt32 replWriterWorkerId;
-    void initializeWriterThread() {
+    static AtomicUInt32 replWorkerId;
+    // The repl executor's threads both prefetch and write, so each task calls this
+    void initializeReplWorker() {
         // Only do this once per thread
         if (!ClientBasic::getCurrent()) {
-            string threadName = str::stream() << "repl writer worker " << replWriterWorkerId.addAndFetch(1);
+            string threadName = str::stream() << "repl worker " << replWorkerId.addAndFetch(1);
             Client::initThread( threadName.c_str() );
-            // allow us to get through the magic barrier
-            Lock::ParallelBatchWriterMode::iAmABatchParticipant();
+            Lock::scheduleThreadAs( Lock::ReplApply );
             replLocalAuth();
         }
     }
 
     // This free function is used by the writer threads to apply each op
     void multiSyncApply(const std::vector<BSONObj>& ops, SyncTail* st) {
-        initializeWriterThread();
+        initializeReplWorker();
 
         // convert update operations only for 2.2.1 or greater, because we need guaranteed
         // idempotent operations for this to work.  See SERVER-6825
@@ -129,7 +122,7 @@ namespace replset {
 
     // This free function is used by the initial sync writer threads to apply each op
     void multiInitialSyncApply(const std::vector<BSONObj>& ops, SyncTail* st) {
-        initializeWriterThread();
+        initializeReplWorker();
         for (std::vector<BSONObj>::const_iterator it = ops.begin();
              it != ops.end();
              ++it) {
@@ -159,7 +152,7 @@ namespace replset {
 
     // The pool threads call this to prefetch each op
     void SyncTail::prefetchOp(const BSONObj& op) {
-        initializePrefetchThread();
+        initializeReplWorker();
 
         const char *ns = op.getStringField("ns");
         if (ns && (ns[0] != '\0')) {
@@ -179,35 +172,46 @@ namespace replset {
         }
     }
 
-    // Doles out all the work to the reader pool threads and waits for them to complete
+    // Doles out all the work to the repl workers and waits for them to complete
     void SyncTail::prefetchOps(const std::deque<BSONObj>& ops) {
-        threadpool::ThreadPool& prefetcherPool = theReplSet->getPrefetchPool();
+        TaskExecutor::Group prefetchers(theReplSet->getReplExecutor(), TaskExecutor::Normal);
         for (std::deque<BSONObj>::const_iterator it = ops.begin();
              it != ops.end();
              ++it) {
-            prefetcherPool.schedule(&prefetchOp, *it);
+            prefetchers.schedule(&prefetchOp, *it);
         }
-        prefetcherPool.join();
+        prefetchers.join();
+    }
+
+    // The repl workers call this to apply each writer vector, inside the calling thread's batch
+    static void applyBatchPart(void (*applyFunc)(const std::vector<BSONObj>&, SyncTail*),
+                               const std::vector<BSONObj>* ops,
+                               SyncTail* st) {
+        initializeReplWorker();
+        // allow us to get through the magic barrier, for this task only as the thread is shared
+        Lock::ParallelBatchWriterMode::Participant participant;
+        applyFunc(*ops, st);
     }
     
-    // Doles out all the work to the writer pool threads and waits for them to complete
+    // Doles out all the work to the repl workers and waits for them to complete
     void SyncTail::applyOps(const std::vector< std::vector<BSONObj> >& writerVectors, 
                                      MultiSyncApplyFunc applyFunc) {
-        ThreadPool& writerPool = theReplSet->getWriterPool();
+        // writers go ahead of anything else queued, as readers are blocked until they're done
+        TaskExecutor::Group writers(theReplSet->getReplExecutor(), TaskExecutor::High);
         for (std::vector< std::vector<BSONObj> >::const_iterator it = writerVectors.begin();
              it != writerVectors.end();
              ++it) {
             if (!it->empty()) {
-                writerPool.schedule(applyFunc, boost::cref(*it), this);
+                writers.schedule(&applyBatchPart, applyFunc, &*it, this);
             }
         }
-        writerPool.join();
+        writers.join();
     }
 
     // Doles out all the work to the writer pool threads and waits for them to complete
     void SyncTail::multiApply( std::deque<BSONObj>& ops, MultiSyncApplyFunc applyFunc ) {
 
-        // Use a ThreadPool to prefetch all the operations in a batch.
+        // Use the repl workers to prefetch all the operations in a batch.
         prefetchOps(ops);
         
         std::vector< std::vector<BSONObj> > writerVectors(theReplSet->replWriterThreadCount);
@@ -727,6 +731,7 @@ namespace replset {
         n++;
 
         Client::initThread("rsSync");
+        Lock::scheduleThreadAs( Lock::ReplApply );
         replLocalAuth();
         theReplSet->syncThread();
         cc().shutdown();
@@ -48,32 +48,22 @@ namespace mongo {
     void OpCounters::_checkWrap() {
         const unsigned MAX = 1 << 30;
         
-        bool wrap =
-            _insert.get() > MAX ||
-            _query.get() > MAX ||
-            _update.get() > MAX ||
-            _delete.get() > MAX ||
-            _getmore.get() > MAX ||
-            _command.get() > MAX;
+        bool wrap = false;
+        for ( int i = 0; i < NCOUNTERS; i++ )
+            wrap = wrap || _get( i ) > MAX;
         
-        if ( wrap ) {
-            _insert.zero();
-            _query.zero();
-            _update.zero();
-            _delete.zero();
-            _getmore.zero();
-            _command.zero();
-        }
+        if ( wrap )
+            _counters.reset();
     }
 
     BSONObj OpCounters::getObj() const {
         BSONObjBuilder b;
-        b.append( "insert" , _insert.get() );
-        b.append( "query" , _query.get() );
-        b.append( "update" , _update.get() );
-        b.append( "delete" , _delete.get() );
-        b.append( "getmore" , _getmore.get() );
-        b.append( "command" , _command.get() );
+        b.append( "insert" , getInsert() );
+        b.append( "query" , getQuery() );
+        b.append( "update" , getUpdate() );
+        b.append( "delete" , getDelete() );
+        b.append( "getmore" , getGetMore() );
+        b.append( "command" , getCommand() );
         return b.obj();
     }
 
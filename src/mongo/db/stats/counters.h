@@ -22,50 +22,47 @@
 #include "../../util/net/message.h"
 #include "../../util/processinfo.h"
 #include "../../util/concurrency/spin_lock.h"
+#include "mongo/util/concurrency/striped_counter.h"
 #include "mongo/db/pdfile.h"
 
 namespace mongo {
 
     /**
      * for storing operation counters
-     * note: not thread safe.  ok with that for speed
+     * striped per thread so operations on different cores don't contend for the counters
      */
     class OpCounters {
     public:
 
         OpCounters();
-        void incInsertInWriteLock(int n) { _insert.x += n; }
-        void gotInsert() { _insert++; }
-        void gotQuery() { _query++; }
-        void gotUpdate() { _update++; }
-        void gotDelete() { _delete++; }
-        void gotGetMore() { _getmore++; }
-        void gotCommand() { _command++; }
+        void incInsertInWriteLock(int n) { _counters.add( INSERTS , n ); }
+        void gotInsert() { _counters.add( INSERTS , 1 ); }
+        void gotQuery() { _counters.add( QUERIES , 1 ); }
+        void gotUpdate() { _counters.add( UPDATES , 1 ); }
+        void gotDelete() { _counters.add( DELETES , 1 ); }
+        void gotGetMore() { _counters.add( GETMORES , 1 ); }
+        void gotCommand() { _counters.add( COMMANDS , 1 ); }
 
         void gotOp( int op , bool isCommand );
 
         BSONObj getObj() const;
         
         // thse are used by snmp, and other things, do not remove
-        const AtomicUInt * getInsert() const { return &_insert; }
-        const AtomicUInt * getQuery() const { return &_query; }
-        const AtomicUInt * getUpdate() const { return &_update; }
-        const AtomicUInt * getDelete() const { return &_delete; }
-        const AtomicUInt * getGetMore() const { return &_getmore; }
-        const AtomicUInt * getCommand() const { return &_command; }
+        unsigned getInsert() const { return _get( INSERTS ); }
+        unsigned getQuery() const { return _get( QUERIES ); }
+        unsigned getUpdate() const { return _get( UPDATES ); }
+        unsigned getDelete() const { return _get( DELETES ); }
+        unsigned getGetMore() const { return _get( GETMORES ); }
+        unsigned getCommand() const { return _get( COMMANDS ); }
 
 
     private:
+        enum { INSERTS , QUERIES , UPDATES , DELETES , GETMORES , COMMANDS , NCOUNTERS };
+
+        unsigned _get( int counter ) const { return static_cast<unsigned>( _counters.get( counter ) ); }
         void _checkWrap();
         
-        // todo: there will be a lot of cache line contention on these.  need to do something 
-        //       else eventually.
-        AtomicUInt _insert;
-        AtomicUInt _query;
-        AtomicUInt _update;
-        AtomicUInt _delete;
-        AtomicUInt _getmore;
-        AtomicUInt _command;
+        StripedCounters<NCOUNTERS> _counters;
     };
 
     extern OpCounters globalOpCounters;
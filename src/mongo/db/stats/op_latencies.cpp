@@ -0,0 +1,56 @@
+// op_latencies.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/pch.h"
+
+#include "mongo/db/stats/op_latencies.h"
+
+#include "mongo/util/net/message.h"
+
+namespace mongo {
+
+    OpLatencies::OpLatencies() : ServerStatusSection( "opLatencies" ) {
+    }
+
+    void OpLatencies::record( int op , bool isCommand , long long micros ) {
+        switch ( op ) {
+        case dbInsert: _histograms[INSERTS].record( micros ); break;
+        case dbQuery: _histograms[ isCommand ? COMMANDS : QUERIES ].record( micros ); break;
+        case dbUpdate: _histograms[UPDATES].record( micros ); break;
+        case dbDelete: _histograms[DELETES].record( micros ); break;
+        case dbGetMore: _histograms[GETMORES].record( micros ); break;
+        default: break;
+        }
+    }
+
+    BSONObj OpLatencies::generateSection( const BSONElement& configElement, bool userIsAdmin ) const {
+        static const char* const names[NTYPES] =
+            { "insert" , "query" , "update" , "delete" , "getmore" , "command" };
+
+        BSONObjBuilder b;
+        for ( int i = 0; i < NTYPES; i++ ) {
+            BSONObjBuilder bb( b.subobjStart( names[i] ) );
+            _histograms[i].append( bb );
+            bb.done();
+        }
+        return b.obj();
+    }
+
+    OpLatencies globalOpLatencies;
+
+}
@@ -0,0 +1,51 @@
+// op_latencies.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "mongo/db/commands/server_status.h"
+#include "mongo/util/latency_histogram.h"
+
+namespace mongo {
+
+    /**
+     * Latency histograms of every operation by type, the serverStatus section "opLatencies":
+     *   { insert : { count : n , p50 : micros , p99 : micros , p999 : micros , buckets : [...] },
+     *     query : ... , update : ... , delete : ... , getmore : ... , command : ... }
+     * The op types are the ones of "opcounters".
+     */
+    class OpLatencies : public ServerStatusSection {
+    public:
+        OpLatencies();
+
+        virtual bool includeByDefault() const { return true; }
+        virtual bool adminOnly() const { return false; }
+
+        virtual BSONObj generateSection( const BSONElement& configElement, bool userIsAdmin ) const;
+
+        /** @param micros the time the whole operation took */
+        void record( int op , bool isCommand , long long micros );
+
+    private:
+        enum { INSERTS , QUERIES , UPDATES , DELETES , GETMORES , COMMANDS , NTYPES };
+
+        LatencyHistogram _histograms[ NTYPES ];
+    };
+
+    extern OpLatencies globalOpLatencies;
+}
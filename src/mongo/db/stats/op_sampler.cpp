@@ -0,0 +1,142 @@
+// op_sampler.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/pch.h"
+
+#include "mongo/db/stats/op_sampler.h"
+
+#include "mongo/db/commands.h"
+
+namespace mongo {
+
+    void OpSampler::run() {
+        Client::initThread( "opsampler" );
+        Client& client = cc();
+
+        while ( ! inShutdown() ) {
+            try {
+                _sample();
+            }
+            catch ( std::exception& e ) {
+                log() << "ERROR in OpSampler: " << e.what() << endl;
+            }
+            sleepmillis( IntervalMillis );
+        }
+
+        client.shutdown();
+    }
+
+    void OpSampler::_sample() {
+        vector< pair<string,OpStage> > active;
+        {
+            scoped_lock bl( Client::clientsMutex );
+            for ( set<Client*>::iterator i = Client::clients.begin(); i != Client::clients.end(); ++i ) {
+                CurOp* op = (*i)->curop();
+                if ( ! op || ! op->active() )
+                    continue;
+                const char* ns = op->getNS();
+                if ( ! ns[0] )
+                    continue;
+                active.push_back( make_pair( string( ns ) , op->stage() ) );
+            }
+        }
+
+        unsigned long long now = curTimeMillis64();
+
+        scoped_lock lk( _lock );
+        if ( _current.start == 0 ) {
+            _current.start = now;
+        }
+        else if ( now - _current.start >= WindowSecs * 1000ULL ) {
+            _previous = _current;
+            _current = Window();
+            _current.start = now;
+        }
+
+        _current.ticks++;
+        for ( unsigned i = 0; i < active.size(); i++ ) {
+            vector<long long>& samples = _current.samples[ active[i].first ];
+            if ( samples.empty() )
+                samples.resize( OpStageCount );
+            samples[ active[i].second ]++;
+        }
+    }
+
+    void OpSampler::append( BSONObjBuilder& b ) const {
+        b.append( "intervalMillis" , IntervalMillis );
+        b.append( "windowSecs" , WindowSecs );
+
+        scoped_lock lk( _lock );
+        if ( _current.start ) {
+            BSONObjBuilder bb( b.subobjStart( "current" ) );
+            _current.append( bb );
+            bb.done();
+        }
+        if ( _previous.start ) {
+            BSONObjBuilder bb( b.subobjStart( "previous" ) );
+            _previous.append( bb );
+            bb.done();
+        }
+    }
+
+    void OpSampler::Window::append( BSONObjBuilder& b ) const {
+        b.appendDate( "start" , start );
+        b.append( "samples" , ticks );
+
+        // estimated millis, by namespace and then stage
+        BSONObjBuilder namespaces( b.subobjStart( "namespaces" ) );
+        for ( Samples::const_iterator i = samples.begin(); i != samples.end(); ++i ) {
+            BSONObjBuilder ns( namespaces.subobjStart( i->first ) );
+            long long total = 0;
+            for ( int stage = 0; stage < OpStageCount; stage++ )
+                total += i->second[stage];
+            ns.append( "total" , total * IntervalMillis );
+            for ( int stage = 0; stage < OpStageCount; stage++ ) {
+                if ( i->second[stage] )
+                    ns.append( opStageName( static_cast<OpStage>( stage ) ) ,
+                               i->second[stage] * IntervalMillis );
+            }
+            ns.done();
+        }
+        namespaces.done();
+    }
+
+    class SampledOpsCmd : public Command {
+    public:
+        SampledOpsCmd() : Command( "sampledOps" ) {}
+
+        virtual bool slaveOk() const { return true; }
+        virtual bool adminOnly() const { return true; }
+        virtual LockType locktype() const { return NONE; }
+        virtual void help( stringstream& help ) const {
+            help << "estimated time spent by operations in progress, in millis, "
+                    "by namespace and stage (lockWait, pageFault, scan, match, write, "
+                    "journalWait, other), from sampling them every "
+                 << OpSampler::IntervalMillis << "ms";
+        }
+
+        virtual bool run(const string& , BSONObj& cmdObj, int, string& errmsg, BSONObjBuilder& result, bool fromRepl) {
+            opSampler.append( result );
+            return true;
+        }
+
+    } sampledOpsCmd;
+
+    OpSampler opSampler;
+
+}
@@ -0,0 +1,67 @@
+// op_sampler.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "mongo/pch.h"
+#include "mongo/db/curop.h"
+#include "mongo/util/background.h"
+
+namespace mongo {
+
+    /**
+     * Every IntervalMillis, looks at what each operation in progress is doing (its namespace
+     * and OpStage) and counts it, so the counts times the interval estimate where server time
+     * went.  The counts are kept over windows of WindowSecs; the "sampledOps" command reports
+     * the current window and the previous one.
+     *
+     * Sampling only reads the ops, under Client::clientsMutex as currentOp does, so it's
+     * always on.
+     */
+    class OpSampler : public BackgroundJob {
+    public:
+        enum { IntervalMillis = 10 , WindowSecs = 60 };
+
+        OpSampler() : _lock("OpSampler") { }
+
+        virtual string name() const { return "OpSampler"; }
+        virtual void run();
+
+        void append( BSONObjBuilder& b ) const;
+
+    private:
+        typedef map< string , vector<long long> > Samples; // ns -> samples by OpStage
+
+        struct Window {
+            Window() : start(0), ticks(0) { }
+            void append( BSONObjBuilder& b ) const;
+
+            unsigned long long start;   // millis
+            long long ticks;
+            Samples samples;
+        };
+
+        void _sample();
+
+        mutable mongo::mutex _lock;
+        Window _current;
+        Window _previous;
+    };
+
+    extern OpSampler opSampler;
+}
@@ -42,21 +42,47 @@ namespace mongo {
 
     }
 
+    void Top::CollectionData::add( const CollectionData& other ) {
+        total.add( other.total );
+        readLock.add( other.readLock );
+        writeLock.add( other.writeLock );
+        queries.add( other.queries );
+        getmore.add( other.getmore );
+        insert.add( other.insert );
+        update.add( other.update );
+        remove.add( other.remove );
+        commands.add( other.commands );
+    }
+
     void Top::record( const StringData& ns , int op , int lockType , long long micros , bool command ) {
         if ( ns.data()[0] == '?' )
             return;
 
         //cout << "record: " << ns << "\t" << op << "\t" << command << endl;
-        SimpleMutex::scoped_lock lk(_lock);
+        Stripe& stripe = _stripes[ threadStripe() ];
+        SimpleMutex::scoped_lock lk( stripe.lock );
 
-        if ( ( command || op == dbQuery ) && str::equals( ns.data(), _lastDropped.c_str() ) ) {
-            _lastDropped = "";
+        if ( ( command || op == dbQuery ) && str::equals( ns.data(), stripe.lastDropped.c_str() ) ) {
+            stripe.lastDropped = "";
             return;
         }
 
-        CollectionData& coll = _usage[ns.data()];
+        CollectionData& coll = stripe.usage[ns.data()];
         _record( coll , op , lockType , micros , command );
-        _record( _global , op , lockType , micros , command );
+        _record( stripe.global , op , lockType , micros , command );
+
+        shared_ptr<LatencyHistogram>& latency = stripe.latency[ns.data()];
+        if ( ! latency )
+            latency = _latencyFor( ns.data() );
+        latency->record( micros );
+    }
+
+    shared_ptr<LatencyHistogram> Top::_latencyFor( const string& ns ) {
+        SimpleMutex::scoped_lock lk( _latencyLock );
+        shared_ptr<LatencyHistogram>& latency = _latency[ns];
+        if ( ! latency )
+            latency.reset( new LatencyHistogram() );
+        return latency;
     }
 
     void Top::_record( CollectionData& c , int op , int lockType , long long micros , bool command ) {
@@ -103,22 +129,54 @@ namespace mongo {
 
     void Top::collectionDropped( const string& ns ) {
         //cout << "collectionDropped: " << ns << endl;
-        SimpleMutex::scoped_lock lk(_lock);
-        _usage.erase(ns);
-        _lastDropped = ns;
+        for ( int i = 0; i < StripeCount; i++ ) {
+            SimpleMutex::scoped_lock lk( _stripes[i].lock );
+            _stripes[i].usage.erase(ns);
+            _stripes[i].latency.erase(ns);
+        }
+        {
+            SimpleMutex::scoped_lock lk( _latencyLock );
+            _latency.erase(ns);
+        }
+
+        // the drop itself is recorded next, by this thread
+        Stripe& stripe = _stripes[ threadStripe() ];
+        SimpleMutex::scoped_lock lk( stripe.lock );
+        stripe.lastDropped = ns;
     }
 
     void Top::cloneMap(Top::UsageMap& out) const {
-        SimpleMutex::scoped_lock lk(_lock);
-        out = _usage;
+        out.clear();
+        for ( int i = 0; i < StripeCount; i++ ) {
+            SimpleMutex::scoped_lock lk( _stripes[i].lock );
+            const UsageMap& usage = _stripes[i].usage;
+            for ( UsageMap::const_iterator j = usage.begin(); j != usage.end(); ++j )
+                out[j->first].add( j->second );
+        }
+    }
+
+    Top::CollectionData Top::getGlobalData() const {
+        CollectionData global;
+        for ( int i = 0; i < StripeCount; i++ ) {
+            SimpleMutex::scoped_lock lk( _stripes[i].lock );
+            global.add( _stripes[i].global );
+        }
+        return global;
     }
 
     void Top::append( BSONObjBuilder& b ) {
-        SimpleMutex::scoped_lock lk( _lock );
-        _appendToUsageMap( b , _usage );
+        UsageMap usage;
+        cloneMap( usage );
+        LatencyMap latency;
+        {
+            SimpleMutex::scoped_lock lk( _latencyLock );
+            latency = _latency;
+        }
+        _appendToUsageMap( b , usage , latency );
     }
 
-    void Top::_appendToUsageMap( BSONObjBuilder& b , const UsageMap& map ) const {
+    void Top::_appendToUsageMap( BSONObjBuilder& b , const UsageMap& map ,
+                                 const LatencyMap& latency ) const {
         // pull all the names into a vector so we can sort them for the user
         
         vector<string> names;
@@ -145,6 +203,13 @@ namespace mongo {
             _appendStatsEntry( b , "remove" , coll.remove );
             _appendStatsEntry( b , "commands" , coll.commands );
 
+            LatencyMap::const_iterator l = latency.find( names[i] );
+            if ( l != latency.end() ) {
+                BSONObjBuilder lb( b.subobjStart( "latency" ) );
+                l->second->append( lb );
+                lb.done();
+            }
+
             bb.done();
         }
     }
@@ -20,16 +20,23 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "mongo/platform/unordered_map.h"
+#include "mongo/util/concurrency/striped_counter.h"
+#include "mongo/util/latency_histogram.h"
 
 namespace mongo {
 
     /**
      * tracks usage by collection
+     *
+     * Each thread records into its own stripe, with its own mutex and map, so operations
+     * don't all serialize on one lock.  Reads merge the stripes.
+     *
+     * Each namespace also has one LatencyHistogram, shared by the stripes.
      */
     class Top {
 
     public:
-        Top() : _lock("Top") { }
+        Top() : _latencyLock("Top") { }
 
         struct UsageData {
             UsageData() : time(0) , count(0) {}
@@ -41,6 +48,11 @@ namespace mongo {
                 count++;
                 time += micros;
             }
+
+            void add( const UsageData& other ) {
+                count += other.count;
+                time += other.time;
+            }
         };
 
         struct CollectionData {
@@ -61,29 +73,42 @@ namespace mongo {
             UsageData update;
             UsageData remove;
             UsageData commands;
+
+            void add( const CollectionData& other );
         };
 
         typedef unordered_map<string,CollectionData> UsageMap;
+        typedef unordered_map< string , shared_ptr<LatencyHistogram> > LatencyMap;
 
     public:
         void record( const StringData& ns , int op , int lockType , long long micros , bool command );
         void append( BSONObjBuilder& b );
         void cloneMap(UsageMap& out) const;
-        CollectionData getGlobalData() const { return _global; }
+        CollectionData getGlobalData() const;
         void collectionDropped( const string& ns );
 
     public: // static stuff
         static Top global;
 
     private:
-        void _appendToUsageMap( BSONObjBuilder& b , const UsageMap& map ) const;
+        void _appendToUsageMap( BSONObjBuilder& b , const UsageMap& map ,
+                                const LatencyMap& latency ) const;
         void _appendStatsEntry( BSONObjBuilder& b , const char * statsName , const UsageData& map ) const;
         void _record( CollectionData& c , int op , int lockType , long long micros , bool command );
+        shared_ptr<LatencyHistogram> _latencyFor( const string& ns );
+
+        struct Stripe {
+            Stripe() : lock("Top") { }
+            mutable SimpleMutex lock;
+            CollectionData global;
+            UsageMap usage;
+            string lastDropped; // set by the dropping thread, so only in its stripe
+            LatencyMap latency; // cache of _latency
+        };
+        Stripe _stripes[ StripeCount ];
 
-        mutable SimpleMutex _lock;
-        CollectionData _global;
-        UsageMap _usage;
-        string _lastDropped;
+        mutable SimpleMutex _latencyLock;
+        LatencyMap _latency;
     };
 
 } // namespace mongo
@@ -104,6 +104,7 @@ namespace mongo {
 
         virtual void run() {
             Client::initThread( name().c_str() );
+            Lock::scheduleThreadAs( Lock::Background );
 
             while ( ! inShutdown() ) {
                 sleepsecs( 60 );
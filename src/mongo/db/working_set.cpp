@@ -0,0 +1,141 @@
+// working_set.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/pch.h"
+
+#include "mongo/db/working_set.h"
+
+#include <algorithm>
+
+#include "mongo/db/index.h"
+#include "mongo/db/namespace_details.h"
+#include "mongo/db/pdfile.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+
+    void WorkingSetEstimator::Sizes::add(const Sizes& other) {
+        storage += other.storage;
+        touched += other.touched;
+        resident += other.resident;
+        sampledPages += other.sampledPages;
+    }
+
+    void WorkingSetEstimator::Sizes::appendTo(BSONObjBuilder& b, int scale) const {
+        b.appendNumber("storageSize", storage / scale);
+        b.appendNumber("touchedSize", touched / scale);
+        b.appendNumber("residentSize", static_cast<long long>(resident / scale));
+        b.appendNumber("sampledPages", sampledPages);
+    }
+
+    WorkingSetEstimator::WorkingSetEstimator(int windowSecs, int samplesPerExtent)
+        : _samplesPerExtent(samplesPerExtent),
+          _residentSupported(ProcessInfo::blockCheckSupported()) {
+        verify(samplesPerExtent > 0);
+        _windowSecs = Record::touchedPages(windowSecs, &_touched);
+    }
+
+    WorkingSetEstimator::Sizes WorkingSetEstimator::estimate(const NamespaceDetails* nsd) const {
+        Sizes sizes;
+        if (nsd->firstExtent.isNull())
+            return sizes;
+        for (const Extent* e = nsd->firstExtent.ext(); e; e = e->getNextExtent()) {
+            _addExtent(e, &sizes);
+        }
+        return sizes;
+    }
+
+    void WorkingSetEstimator::_addExtent(const Extent* e, Sizes* sizes) const {
+        const char* start = reinterpret_cast<const char*>(e);
+        const char* end = start + e->length;
+        sizes->storage += e->length;
+
+        // the tracked pages the extent is on, found in the sorted pages without walking them
+        std::vector<size_t>::const_iterator first =
+            std::lower_bound(_touched.begin(), _touched.end(), Record::trackedPageOf(start));
+        std::vector<size_t>::const_iterator last =
+            std::upper_bound(first, _touched.end(), Record::trackedPageOf(end - 1));
+        long long touchedBytes = static_cast<long long>(last - first) * Record::TrackedPageSize;
+        sizes->touched += std::min(touchedBytes, static_cast<long long>(e->length));
+
+        if (!_residentSupported)
+            return;
+
+        const long long pageBytes = ProcessInfo::getPageSize();
+        const char* firstPage = static_cast<const char*>(ProcessInfo::alignToStartOfPage(start));
+        const long long pages = (end - firstPage + pageBytes - 1) / pageBytes;
+
+        long long sampled = 0;
+        long long resident = 0;
+        vector<char> inMem;
+        if (pages <= _samplesPerExtent) {
+            if (!ProcessInfo::pagesInMemory(firstPage, pages, &inMem))
+                return;
+            sampled = pages;
+            resident = pages - std::count(inMem.begin(), inMem.end(), 0);
+        }
+        else {
+            // spread over the whole extent, as what's hot is often at one end of it
+            for (int i = 0; i < _samplesPerExtent; i++) {
+                const char* page = firstPage + (pages * i / _samplesPerExtent) * pageBytes;
+                if (!ProcessInfo::pagesInMemory(page, 1, &inMem))
+                    continue;
+                sampled++;
+                if (inMem[0])
+                    resident++;
+            }
+        }
+
+        if (sampled) {
+            sizes->sampledPages += sampled;
+            sizes->resident += static_cast<double>(e->length) * resident / sampled;
+        }
+    }
+
+    WorkingSetEstimator::Sizes WorkingSetEstimator::appendCollection(NamespaceDetails* nsd,
+                                                                     int scale,
+                                                                     BSONObjBuilder& b) const {
+        Sizes total = estimate(nsd);
+        total.appendTo(b, scale);
+
+        BSONObjBuilder indexes(b.subobjStart("indexes"));
+        for (NamespaceDetails::IndexIterator it = nsd->ii(); it.more();) {
+            IndexDetails& idx = it.next();
+            NamespaceDetails* indexNsd = nsdetails(idx.indexNamespace().c_str());
+            if (!indexNsd)
+                continue;
+
+            Sizes sizes = estimate(indexNsd);
+            BSONObjBuilder ib(indexes.subobjStart(idx.indexName()));
+            sizes.appendTo(ib, scale);
+            ib.done();
+            total.add(sizes);
+        }
+        indexes.done();
+
+        return total;
+    }
+
+    void WorkingSetEstimator::appendInfo(BSONObjBuilder& b) const {
+        b.append("note", "thisIsAnEstimate");
+        b.append("windowSecs", _windowSecs);
+        b.append("samplesPerExtent", _samplesPerExtent);
+        b.appendBool("residentSupported", _residentSupported);
+    }
+
+}
@@ -0,0 +1,89 @@
+// working_set.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+    class Extent;
+    class NamespaceDetails;
+
+    /**
+     * Estimates how much of the storage of collections and indexes is in the working set, so
+     * it's clear which collections to shard or move before they stop fitting in RAM.
+     *
+     * For each extent, "touched" is the pages accessed within the window according to the
+     * tracking behind Record::likelyInPhysicalMemory(), taken once when the estimator is made,
+     * and "resident" is the pages the OS has in RAM according to mincore over a sample of the
+     * extent's pages.  Both are estimates.
+     *
+     * Needs at least a read lock on the database of the namespaces it looks at.
+     */
+    class WorkingSetEstimator : boost::noncopyable {
+    public:
+        enum { DefaultSamplesPerExtent = 256 };
+
+        /** in bytes */
+        struct Sizes {
+            Sizes() : storage(0), touched(0), resident(0), sampledPages(0) {}
+
+            void add(const Sizes& other);
+
+            /** appends the sizes divided by scale */
+            void appendTo(BSONObjBuilder& b, int scale) const;
+
+            long long storage;
+            long long touched;
+            double resident;
+            long long sampledPages; // pages mincore was asked about
+        };
+
+        /**
+         * @param windowSecs count pages touched within about this many seconds, <= 0 for as far
+         *                   back as the tracking remembers
+         * @param samplesPerExtent ask mincore about at most this many pages of each extent
+         */
+        WorkingSetEstimator(int windowSecs, int samplesPerExtent = DefaultSamplesPerExtent);
+
+        Sizes estimate(const NamespaceDetails* nsd) const;
+
+        /**
+         * Appends the sizes of a collection and, under "indexes", of each of its indexes.
+         * @return the collection's sizes plus its indexes'
+         */
+        Sizes appendCollection(NamespaceDetails* nsd, int scale, BSONObjBuilder& b) const;
+
+        /** appends what the estimates cover */
+        void appendInfo(BSONObjBuilder& b) const;
+
+    private:
+        void _addExtent(const Extent* e, Sizes* sizes) const;
+
+        int _windowSecs;
+        const int _samplesPerExtent;
+        const bool _residentSupported;
+        std::vector<size_t> _touched; // sorted, see Record::trackedPageOf()
+    };
+
+}
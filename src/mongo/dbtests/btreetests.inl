@@ -274,6 +274,45 @@
         }
     };
 
+    /** increasing keys take the right spine append path, and mix with ordinary inserts */
+    class AppendIncreasing : public Base {
+    public:
+        void run() {
+            for ( int i = 0; i < 200; ++i ) {
+                insert( 2 * i );
+            }
+            checkValid( 200 );
+            ASSERT( !bt()->getNextChild().isNull() );
+            // out of order keys still descend normally
+            insert( 101 );
+            insert( 1 );
+            checkValid( 202 );
+            for ( int i = 400; i < 420; ++i ) {
+                insert( i );
+            }
+            checkValid( 222 );
+            for ( int i = 0; i < 200; ++i ) {
+                ASSERT( present( 2 * i ) );
+            }
+            ASSERT( present( 1 ) );
+            ASSERT( present( 101 ) );
+            ASSERT( present( 419 ) );
+            ASSERT( !present( 103 ) );
+        }
+    private:
+        static BSONObj key( long long n ) {
+            return BSON( "a" << bigNumString( n ) );
+        }
+        void insert( long long n ) {
+            BSONObj k = key( n );
+            Base::insert( k );
+        }
+        bool present( long long n ) {
+            BSONObj k = key( n );
+            return Base::present( k, 1 ) && Base::present( k, -1 );
+        }
+    };
+
     class SERVER983 : public Base {
     public:
         void run() {
@@ -1647,6 +1686,7 @@
             add< SplitLeftHeavyBucket >();
             add< MissingLocate >();
             add< MissingLocateMultiBucket >();
+            add< AppendIncreasing >();
             add< SERVER983 >();
             add< DontReuseUnused >();
             add< PackUnused >();
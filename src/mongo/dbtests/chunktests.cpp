@@ -19,6 +19,7 @@
 #include "pch.h"
 
 #include "../s/chunk.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/json.h"
 
 #include "dbtests.h"
@@ -236,6 +237,130 @@ namespace ChunkTests {
             }
         };
 
+        class HashedKeyBase {
+        public:
+            virtual ~HashedKeyBase() {}
+        protected:
+            static long long hashOf( int value ) {
+                return BSONElementHasher::hash64( BSON( "" << value ).firstElement(),
+                                                  BSONElementHasher::DEFAULT_HASH_SEED );
+            }
+            /** shard "0" owns negative hashes and shard "1" the rest */
+            static string shardNameFor( int value ) { return hashOf( value ) < 0 ? "0" : "1"; }
+            void setUp( ChunkManager& chunkManager ) const {
+                chunkManager.setShardKey( BSON( "a" << "hashed" ) );
+                vector<BSONObj> splitPoints;
+                splitPoints.push_back( BSON( "a" << 0LL ) );
+                chunkManager.setSingleChunkForShards( splitPoints );
+            }
+        };
+
+        class HashedEqualitySingleShard : public HashedKeyBase {
+        public:
+            void run() {
+                ChunkManager chunkManager;
+                setUp( chunkManager );
+                for( int i = 0; i < 20; ++i ) {
+                    set<Shard> shards;
+                    chunkManager.getShardsForQuery( shards, BSON( "a" << i ) );
+                    ASSERT_EQUALS( 1U, shards.size() );
+                    ASSERT_EQUALS( shardNameFor( i ), shards.begin()->getName() );
+                }
+            }
+        };
+
+        class HashedInSplitByShard : public HashedKeyBase {
+        public:
+            void run() {
+                ChunkManager chunkManager;
+                setUp( chunkManager );
+
+                BSONArrayBuilder values;
+                map<string,BSONArrayBuilder*> expected;
+                expected[ "0" ] = new BSONArrayBuilder();
+                expected[ "1" ] = new BSONArrayBuilder();
+                for( int i = 0; i < 20; ++i ) {
+                    values << i;
+                    *expected[ shardNameFor( i ) ] << i;
+                }
+
+                map<Shard,BSONObj> shardQueries;
+                ASSERT( chunkManager.splitInQueryByShard(
+                            BSON( "a" << BSON( "$in" << values.arr() ) << "b" << 1 ),
+                            shardQueries ) );
+                ASSERT_EQUALS( 2U, shardQueries.size() );
+                for( map<Shard,BSONObj>::const_iterator i = shardQueries.begin();
+                     i != shardQueries.end(); ++i ) {
+                    ASSERT_EQUALS( BSON( "a" << BSON( "$in" << expected[ i->first.getName() ]->arr() ) <<
+                                         "b" << 1 ),
+                                   i->second );
+                }
+                delete expected[ "0" ];
+                delete expected[ "1" ];
+            }
+        };
+
+        class InSplitBase : public Base {
+        public:
+            void run() {
+                ChunkManager chunkManager;
+                chunkManager.setShardKey( shardKey() );
+                chunkManager.setSingleChunkForShards( splitPointsVector() );
+
+                map<Shard,BSONObj> shardQueries;
+                bool split = chunkManager.splitInQueryByShard( query(), shardQueries );
+                ASSERT_EQUALS( expectSplit(), split );
+
+                BSONObjBuilder b;
+                for( map<Shard,BSONObj>::const_iterator i = shardQueries.begin();
+                     i != shardQueries.end(); ++i ) {
+                    b.append( i->first.getName(), i->second );
+                }
+                ASSERT_EQUALS( expectedShardQueries(), b.obj() );
+            }
+        protected:
+            virtual BSONArray splitPoints() const {
+                return BSON_ARRAY( BSON( "a" << "x" ) << BSON( "a" << "y" ) << BSON( "a" << "z" ) );
+            }
+            virtual bool expectSplit() const { return true; }
+            virtual BSONObj expectedShardQueries() const = 0;
+        };
+
+        class InSplitMultiShard : public InSplitBase {
+            virtual BSONObj query() const {
+                return fromjson( "{a:{$in:['u','y','v','zz']},b:1}" );
+            }
+            virtual BSONObj expectedShardQueries() const {
+                return fromjson( "{'0':{a:{$in:['u','v']},b:1},"
+                                 "'2':{a:{$in:['y']},b:1},"
+                                 "'3':{a:{$in:['zz']},b:1}}" );
+            }
+        };
+
+        class InSplitCompoundKey : public InSplitBase {
+            virtual BSONObj shardKey() const { return BSON( "a" << 1 << "b" << 1 ); }
+            virtual BSONArray splitPoints() const {
+                return BSON_ARRAY( BSON( "a" << 5 << "b" << 10 ) << BSON ( "a" << 6 << "b" << 0 ) );
+            }
+            virtual BSONObj query() const { return fromjson( "{a:{$in:[1,5,7]}}" ); }
+            // 5 spans the chunks on both sides of { a : 5, b : 10 }
+            virtual BSONObj expectedShardQueries() const {
+                return fromjson( "{'0':{a:{$in:[1,5]}},'1':{a:{$in:[5]}},'2':{a:{$in:[7]}}}" );
+            }
+        };
+
+        class InSplitRegexNotSplit : public InSplitBase {
+            virtual BSONObj query() const { return fromjson( "{a:{$in:['u',/^y/]}}" ); }
+            virtual bool expectSplit() const { return false; }
+            virtual BSONObj expectedShardQueries() const { return BSONObj(); }
+        };
+
+        class InSplitOtherFieldNotSplit : public InSplitBase {
+            virtual BSONObj query() const { return fromjson( "{b:{$in:['u','y']}}" ); }
+            virtual bool expectSplit() const { return false; }
+            virtual BSONObj expectedShardQueries() const { return BSONObj(); }
+        };
+
     } // namespace ChunkManagerTests
     
     class All : public Suite {
@@ -264,6 +389,12 @@ namespace ChunkTests {
             add<ChunkManagerTests::InequalityThenUnsatisfiable>();
             add<ChunkManagerTests::OrEqualityUnsatisfiableInequality>();
             add<ChunkManagerTests::InMultiShard>();
+            add<ChunkManagerTests::HashedEqualitySingleShard>();
+            add<ChunkManagerTests::HashedInSplitByShard>();
+            add<ChunkManagerTests::InSplitMultiShard>();
+            add<ChunkManagerTests::InSplitCompoundKey>();
+            add<ChunkManagerTests::InSplitRegexNotSplit>();
+            add<ChunkManagerTests::InSplitOtherFieldNotSplit>();
         }
     } myall;
     
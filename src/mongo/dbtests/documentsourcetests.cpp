@@ -1423,6 +1423,63 @@ namespace DocumentSourceTests {
                 ASSERT_EQUALS( 1U, dependencies.count( "b.c" ) );
             }
         };
+
+        /** The router half of a split sort merges the shards' presorted outputs. */
+        class MergePresortedShards : public Base {
+        public:
+            void run() {
+                createSort( BSON( "a" << 1 << "b" << -1 ) );
+                SplittableDocumentSource *splittable =
+                        dynamic_cast<SplittableDocumentSource*>( sort() );
+                ASSERT( splittable );
+                ASSERT_EQUALS( sort(), splittable->getShardSource().get() );
+                intrusive_ptr<DocumentSource> merger = splittable->getRouterSource();
+                ASSERT_NOT_EQUALS( sort(), merger.get() );
+
+                DocumentSourceCommandShards::ShardOutput shardOutput;
+                shardOutput[ Shard( "s0", "localhost:30000" ) ] =
+                        fromjson( "{ok:1,result:[{a:1,b:2},{a:4,b:0},{a:6,b:0}]}" );
+                shardOutput[ Shard( "s1", "localhost:30001" ) ] =
+                        fromjson( "{ok:1,result:[]}" );
+                shardOutput[ Shard( "s2", "localhost:30002" ) ] =
+                        fromjson( "{ok:1,result:[{a:1,b:3},{a:1,b:1},{a:5,b:0}]}" );
+                intrusive_ptr<DocumentSource> shards =
+                        DocumentSourceCommandShards::create( shardOutput, ctx() );
+                merger->setSource( shards.get() );
+
+                BSONArrayBuilder results;
+                for( bool hasNext = !merger->eof(); hasNext; hasNext = merger->advance() ) {
+                    BSONObjBuilder bob;
+                    merger->getCurrent()->toBson( &bob );
+                    results << bob.obj();
+                }
+                ASSERT( merger->eof() );
+                ASSERT( !merger->getCurrent() );
+
+                BSONObj expected = fromjson( "{'':[{a:1,b:3},{a:1,b:2},{a:1,b:1},"
+                                             "{a:4,b:0},{a:5,b:0},{a:6,b:0}]}" );
+                ASSERT_EQUALS( expected[ "" ].embeddedObject(), results.arr() );
+            }
+        };
+
+        /** A merging sort fails when a shard reported an error. */
+        class MergeShardError : public Base {
+        public:
+            void run() {
+                createSort();
+                intrusive_ptr<DocumentSource> merger =
+                        dynamic_cast<SplittableDocumentSource*>( sort() )->getRouterSource();
+
+                DocumentSourceCommandShards::ShardOutput shardOutput;
+                shardOutput[ Shard( "s0", "localhost:30000" ) ] =
+                        fromjson( "{ok:0,errmsg:'failed'}" );
+                intrusive_ptr<DocumentSource> shards =
+                        DocumentSourceCommandShards::create( shardOutput, ctx() );
+                merger->setSource( shards.get() );
+
+                ASSERT_THROWS( merger->eof(), UserException );
+            }
+        };
         
     } // namespace DocumentSourceSort
 
@@ -1828,6 +1885,8 @@ namespace DocumentSourceTests {
             add<DocumentSourceSort::MissingObjectWithinArray>();
             add<DocumentSourceSort::ExtractArrayValues>();
             add<DocumentSourceSort::Dependencies>();
+            add<DocumentSourceSort::MergePresortedShards>();
+            add<DocumentSourceSort::MergeShardError>();
 
             add<DocumentSourceUnwind::EofInit>();
             add<DocumentSourceUnwind::AdvanceInit>();
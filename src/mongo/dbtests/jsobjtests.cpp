@@ -576,6 +576,39 @@ namespace JsobjTests {
             }
         };
 
+        /** KeyV1 comparisons of compound keys sharing leading elements. */
+        class KeyV1SharedPrefix {
+        public:
+            void run() {
+                Ordering asc = Ordering::make( BSONObj() );
+                Ordering desc = Ordering::make( BSON( "a" << 1 << "b" << -1 << "c" << 1 ) );
+                BSONObj keys[] = {
+                    BSON( "" << "tenant" << "" << 1 << "" << "x" ),
+                    BSON( "" << "tenant" << "" << 1 << "" << "xy" ),
+                    BSON( "" << "tenant" << "" << 1.5 << "" << "x" ),
+                    BSON( "" << "tenant" << "" << 2 ),
+                    BSON( "" << "tenant" << "" << 2 << "" << true ),
+                    BSON( "" << "tenantb" << "" << 1 ),
+                    BSON( "" << "tenant" << "" << 1.0 << "" << "x" ),
+                    BSON( "" << "tenant" << "" << 1 << "" << BSONObj() )
+                };
+                int n = sizeof( keys ) / sizeof( keys[ 0 ] );
+                for( int i = 0; i < n; ++i ) {
+                    for( int j = 0; j < n; ++j ) {
+                        KeyV1Owned l( keys[ i ] );
+                        KeyV1Owned r( keys[ j ] );
+                        ASSERT_EQUALS( sign( keys[ i ].woCompare( keys[ j ], BSONObj(), false ) ),
+                                       sign( l.woCompare( r, asc ) ) );
+                        BSONObj descPattern = BSON( "a" << 1 << "b" << -1 << "c" << 1 );
+                        ASSERT_EQUALS( sign( keys[ i ].woCompare( keys[ j ], descPattern, false ) ),
+                                       sign( l.woCompare( r, desc ) ) );
+                    }
+                }
+            }
+        private:
+            static int sign( int x ) { return x < 0 ? -1 : ( x > 0 ? 1 : 0 ); }
+        };
+
         class ToStringArray {
         public:
             void run() {
@@ -2043,6 +2076,7 @@ namespace JsobjTests {
             add< BSONObjTests::AsTempObj >();
             add< BSONObjTests::AppendIntOrLL >();
             add< BSONObjTests::AppendNumber >();
+            add< BSONObjTests::KeyV1SharedPrefix >();
             add< BSONObjTests::ToStringArray >();
             add< BSONObjTests::ToStringNumber >();
             add< BSONObjTests::AppendAs >();
@@ -23,6 +23,7 @@
 #include "../db/json.h"
 #include "dbtests.h"
 #include "../db/namespace_details.h"
+#include "../db/queryutil.h"
 
 namespace MatcherTests {
 
@@ -225,6 +226,48 @@ namespace MatcherTests {
             }
         };
         
+        /**
+         * Test that a prior $or clause's range is checked against the key of a following clause
+         * when that key holds all the fields of the prior clause's index.
+         */
+        class OrDedupOnKey : public CollectionBase {
+        public:
+            void run() {
+                Client::ReadContext context( ns() );
+
+                BSONObj query = fromjson( "{ $or:[ { a:1 }, { b:1 } ] }" );
+                CoveredIndexMatcher firstClause( query, BSON( "a" << 1 ) );
+                FieldRangeSet frs( ns(), BSON( "a" << 1 ), true, true );
+                IndexSpec aSpec( BSON( "a" << 1 ) );
+                shared_ptr<FieldRangeVector> aRange( new FieldRangeVector( frs, aSpec, 1 ) );
+
+                scoped_ptr<CoveredIndexMatcher> secondClause
+                        ( firstClause.nextClauseMatcher( aRange, BSON( "b" << 1 << "a" << 1 ) ) );
+                ASSERT( !secondClause->needRecord() );
+                // { b:1, a:1 } was returned by the first clause, { b:1, a:2 } was not.  Neither
+                // record is loaded.
+                ASSERT( !secondClause->matchesWithSingleKeyIndex( BSON( "" << 1 << "" << 1 ),
+                                                                  DiskLoc() ) );
+                ASSERT( secondClause->matchesWithSingleKeyIndex( BSON( "" << 1 << "" << 2 ),
+                                                                 DiskLoc() ) );
+
+                // The { b:1 } key doesn't hold 'a', so the record is needed.
+                scoped_ptr<CoveredIndexMatcher> bOnly
+                        ( firstClause.nextClauseMatcher( aRange, BSON( "b" << 1 ) ) );
+                ASSERT( bOnly->needRecord() );
+
+                // Nor can a sparse index be ruled out from a key that may hold a missing field.
+                IndexSpec sparseSpec( BSON( "a" << 1 ), BSON( "key" << BSON( "a" << 1 ) <<
+                                                               "sparse" << true ) );
+                shared_ptr<FieldRangeVector> sparseRange
+                        ( new FieldRangeVector( frs, sparseSpec, 1 ) );
+                scoped_ptr<CoveredIndexMatcher> afterSparse
+                        ( firstClause.nextClauseMatcher( sparseRange,
+                                                         BSON( "b" << 1 << "a" << 1 ) ) );
+                ASSERT( afterSparse->needRecord() );
+            }
+        };
+
     } // namespace Covered
     
     class TimingBase {
@@ -369,6 +412,7 @@ namespace MatcherTests {
             add<Covered::ElemMatchKeyUnindexed>();
             add<Covered::ElemMatchKeyIndexed>();
             add<Covered::ElemMatchKeyIndexedSingleKey>();
+            add<Covered::OrDedupOnKey>();
             add<AllTiming>();
             add<Visit>();
         }
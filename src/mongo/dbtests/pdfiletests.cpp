@@ -303,6 +303,103 @@ namespace PdfileTests {
                 ASSERT( 0 != o.getField( "a" ).date() );
             }
         };
+
+        class BatchBase : public Base {
+        protected:
+            void insertBatch( vector<BSONObj>& objs, bool keepGoing ) {
+                ASSERT( DataFileMgr::canInsertBatch( ns() ) );
+                size_t n;
+                theDataFileMgr.insertBatch( ns(), objs, keepGoing, n );
+                ASSERT_EQUALS( objs.size(), n );
+            }
+            /** @return the error code thrown, 0 if none */
+            int insertBatchError( vector<BSONObj>& objs, bool keepGoing, size_t expectedDone ) {
+                size_t n = 0;
+                try {
+                    theDataFileMgr.insertBatch( ns(), objs, keepGoing, n );
+                }
+                catch ( UserException& e ) {
+                    ASSERT_EQUALS( expectedDone, n );
+                    return e.getCode();
+                }
+                ASSERT_EQUALS( objs.size(), n );
+                return 0;
+            }
+            DBDirectClient _client;
+        };
+
+        /** keys reach the indexes in key order but the result is the same as single inserts */
+        class BatchIndexes : public BatchBase {
+        public:
+            void run() {
+                _client.ensureIndex( ns(), BSON( "a" << 1 ) );
+                _client.ensureIndex( ns(), BSON( "b" << -1 ) );
+                vector<BSONObj> objs;
+                for ( int i = 0; i < 2500; ++i ) {
+                    int a = ( i * 7919 ) % 2500;
+                    objs.push_back( BSON( "a" << a << "b" << BSON_ARRAY( a << a + 1 ) ) );
+                }
+                insertBatch( objs, false );
+                for ( vector<BSONObj>::const_iterator i = objs.begin(); i != objs.end(); ++i )
+                    ASSERT( i->hasField( "_id" ) );
+
+                ASSERT_EQUALS( 2500, nsd()->stats.nrecords );
+                ASSERT( nsd()->isMultikey( 2 ) );
+                ASSERT( !nsd()->isMultikey( 1 ) );
+                ASSERT_EQUALS( 2500U, _client.count( ns(), BSONObj() ) );
+                ASSERT_EQUALS( 1U, _client.count( ns(), BSON( "a" << 1234 ) ) );
+                ASSERT_EQUALS( 2U, _client.count( ns(), BSON( "b" << 1234 ) ) );
+
+                BSONObj res;
+                ASSERT( _client.runCommand( "unittests", BSON( "validate" << "pdfiletests.Insert" << "full" << true ), res ) );
+                ASSERT( res["valid"].trueValue() );
+            }
+        };
+
+        /** a duplicate within the batch or against the collection stops the batch */
+        class BatchDupStops : public BatchBase {
+        public:
+            void run() {
+                _client.insert( ns(), BSON( "_id" << 5 ) );
+                vector<BSONObj> objs;
+                objs.push_back( BSON( "_id" << 1 ) );
+                objs.push_back( BSON( "_id" << 2 ) );
+                objs.push_back( BSON( "_id" << 1 ) );
+                objs.push_back( BSON( "_id" << 3 ) );
+                ASSERT_EQUALS( (int)ASSERT_ID_DUPKEY, insertBatchError( objs, false, 2 ) );
+                ASSERT_EQUALS( 3U, _client.count( ns(), BSONObj() ) );
+                ASSERT_EQUALS( 0U, _client.count( ns(), BSON( "_id" << 3 ) ) );
+
+                objs.clear();
+                objs.push_back( BSON( "_id" << 4 ) );
+                objs.push_back( BSON( "_id" << 5 ) );
+                ASSERT_EQUALS( (int)ASSERT_ID_DUPKEY, insertBatchError( objs, false, 1 ) );
+                ASSERT_EQUALS( 4U, _client.count( ns(), BSONObj() ) );
+            }
+        };
+
+        /** with keepGoing only the bad documents are skipped */
+        class BatchDupKeepGoing : public BatchBase {
+        public:
+            void run() {
+                _client.insert( ns(), BSON( "_id" << 2 ) );
+                vector<BSONObj> objs;
+                objs.push_back( BSON( "_id" << 1 ) );
+                objs.push_back( BSON( "_id" << 2 ) );
+                objs.push_back( BSON( "_id" << 3 << "$bad" << 1 ) );
+                objs.push_back( BSON( "_id" << 3 ) );
+                ASSERT_EQUALS( 0, insertBatchError( objs, true, 0 ) );
+                ASSERT_EQUALS( 3U, _client.count( ns(), BSONObj() ) );
+
+                // the error is reported when the last document fails
+                objs.clear();
+                objs.push_back( BSON( "_id" << 4 ) );
+                objs.push_back( BSON( "_id" << 4 ) );
+                ASSERT_EQUALS( (int)ASSERT_ID_DUPKEY, insertBatchError( objs, true, 1 ) );
+                ASSERT_EQUALS( 4U, _client.count( ns(), BSONObj() ) );
+            }
+        };
+
     } // namespace Insert
 
     class ExtentSizing {
@@ -398,6 +495,9 @@ namespace PdfileTests {
             add< ScanCapped::FirstInExtent >();
             add< ScanCapped::LastInExtent >();
             add< Insert::UpdateDate >();
+            add< Insert::BatchIndexes >();
+            add< Insert::BatchDupStops >();
+            add< Insert::BatchDupKeepGoing >();
             add< ExtentSizing >();
             add< ExtentAllocOrder >();
         }
@@ -40,6 +40,8 @@
 #include "../db/key.h"
 #include "../util/compress.h"
 #include "../util/concurrency/qlock.h"
+#include "../util/concurrency/task_executor.h"
+#include "../util/concurrency/thread_pool.h"
 #include <boost/filesystem/operations.hpp>
 
 using namespace bson;
@@ -626,6 +628,49 @@ namespace PerfTests {
     };
 #endif
 
+    // schedule a batch of trivial tasks and wait for them, the way replication drives its
+    // writers, to compare the cost of dispatching through ThreadPool and TaskExecutor
+    const int dispatchThreads = 4;
+    const int dispatchBatch = 16;
+    void dispatchNoop() { }
+    ThreadPool& dispatchPool() {
+        static ThreadPool& p = *(new ThreadPool(dispatchThreads));
+        return p;
+    }
+    TaskExecutor& dispatchExecutor() {
+        static TaskExecutor& e = *(new TaskExecutor(dispatchThreads, "perftest"));
+        return e;
+    }
+
+    template< int N >
+    class ThreadPoolDispatch : public B {
+    public:
+        string name() { return str::stream() << "threadpool_dispatch_" << N; }
+        virtual int howLongMillis() { return 1000; }
+        virtual bool showDurStats() { return false; }
+        void prep() { dispatchPool(); }
+        void timed() {
+            ThreadPool& p = dispatchPool();
+            for( int i = 0; i < N; i++ )
+                p.schedule(dispatchNoop);
+            p.join();
+        }
+    };
+    template< int N >
+    class TaskExecutorDispatch : public B {
+    public:
+        string name() { return str::stream() << "taskexecutor_dispatch_" << N; }
+        virtual int howLongMillis() { return 1000; }
+        virtual bool showDurStats() { return false; }
+        void prep() { dispatchExecutor(); }
+        void timed() {
+            TaskExecutor::Group g(dispatchExecutor());
+            for( int i = 0; i < N; i++ )
+                g.schedule(dispatchNoop);
+            g.join();
+        }
+    };
+
     class CTM : public B {
     public:
         CTM() : last(0), delts(0), n(0) { }
@@ -1061,6 +1106,147 @@ namespace PerfTests {
         }
     };
 
+    /** s2 queries over a grid of a million points.  A handful of polygons and $near centers
+        are queried over and over, the way a location service does.
+    */
+    class GeoS2 : public B {
+    public:
+        GeoS2() : _i( 0 ) { }
+        string name() { return "geo-s2-intersect"; }
+        virtual int howLongMillis() { return profiling ? 30000 : 5000; }
+        virtual unsigned batchSize() { return 10; }
+        virtual bool showDurStats() { return false; }
+        void prep() {
+            // points 0.001 degrees apart around lat/lng 0,0
+            int side = 1000;
+            DEV side = 100;
+            vector<BSONObj> batch;
+            for( int x = 0; x < side; x++ ) {
+                batch.clear();
+                for( int y = 0; y < side; y++ ) {
+                    batch.push_back( BSON( "geo" << BSON( "type" << "Point" << "coordinates" <<
+                                                          BSON_ARRAY( x / 1000.0 << y / 1000.0 ) ) ) );
+                }
+                client().insert( ns(), batch );
+            }
+            client().ensureIndex( ns(), BSON( "geo" << "s2d" ) );
+        }
+        void timed() {
+            double lo = 0.01 * ( _i++ % 4 ), hi = lo + 0.02;
+            BSONObj square = BSON( "type" << "Polygon" << "coordinates" <<
+                                   BSON_ARRAY( BSON_ARRAY( BSON_ARRAY( lo << lo ) <<
+                                                           BSON_ARRAY( hi << lo ) <<
+                                                           BSON_ARRAY( hi << hi ) <<
+                                                           BSON_ARRAY( lo << hi ) <<
+                                                           BSON_ARRAY( lo << lo ) ) ) );
+            Query q( BSON( "geo" << BSON( "$intersect" << BSON( "$geometry" << square ) ) ) );
+            auto_ptr<DBClientCursor> c = client().query( ns(), q );
+            verify( c->itcount() > 0 );
+        }
+        string timed2(DBClientBase& c) {
+            double at = 0.01 * ( rand() % 4 ) + 0.0105;
+            BSONObj center = BSON( "type" << "Point" << "coordinates" << BSON_ARRAY( at << at ) );
+            Query q( BSON( "geo" << BSON( "$newnear" << BSON( "$geometry" << center ) ) ) );
+            auto_ptr<DBClientCursor> cursor = c.query( ns(), q, 100 );
+            verify( cursor->itcount() > 0 );
+            return "geo-s2-near";
+        }
+    private:
+        unsigned _i;
+    };
+
+    /** text command over a generated corpus: documents of 50 words drawn from a 5000 word
+        vocabulary with a skewed distribution, so common terms have long postings and rare
+        terms short ones.
+    */
+    class TextSearch : public B {
+    public:
+        TextSearch() : _i( 0 ) { }
+        string name() { return "text-search"; }
+        virtual int howLongMillis() { return profiling ? 30000 : 5000; }
+        virtual unsigned batchSize() { return 10; }
+        virtual bool showDurStats() { return false; }
+        void prep() {
+            int docs = 20000;
+            DEV docs = 2000;
+            vector<BSONObj> batch;
+            for( int i = 0; i < docs; i++ ) {
+                stringstream body;
+                for( int w = 0; w < 50; w++ )
+                    body << word( rand() % ( rand() % Vocabulary + 1 ) ) << ' ';
+                batch.push_back( BSON( "title" << word( i % Vocabulary ) <<
+                                       "body" << body.str() ) );
+                if( batch.size() == 1000 ) {
+                    client().insert( ns(), batch );
+                    batch.clear();
+                }
+            }
+            client().insert( ns(), batch );
+            client().ensureIndex( ns(), BSON( "title" << "text" << "body" << "text" ) );
+        }
+        void timed() {
+            // one common and one rare term
+            string search = word( _i % 10 ) + " " + word( Vocabulary - 1 - _i % 1000 );
+            _i++;
+            BSONObj cmd = BSON( "text" << NamespaceString( ns() ).coll << "search" << search );
+            BSONObj res;
+            verify( client().runCommand( "perftest", cmd, res ) );
+        }
+        string timed2(DBClientBase& c) {
+            BSONObj cmd = BSON( "text" << NamespaceString( ns() ).coll <<
+                                "search" << word( rand() % Vocabulary ) << "limit" << 10 );
+            BSONObj res;
+            verify( c.runCommand( "perftest", cmd, res ) );
+            return "text-search-one-term";
+        }
+    private:
+        enum { Vocabulary = 5000 };
+        /** a distinct lower case word per number, not a stop word and stable under stemming */
+        static string word( int n ) {
+            string w = "q";
+            do {
+                w += static_cast<char>( 'a' + n % 26 );
+                n /= 26;
+            } while( n );
+            return w + "x";
+        }
+        unsigned _i;
+    };
+
+    /** reads a collection of 4KB documents in full, so most of it is returned by large getMores */
+    class LargeBatchQuery : public B {
+    public:
+        string name() { return "large-batch-query"; }
+        virtual int howLongMillis() { return profiling ? 30000 : 5000; }
+        virtual unsigned batchSize() { return 1; }
+        virtual bool showDurStats() { return false; }
+        void prep() {
+            _docs = 10000;
+            DEV _docs = 1000;
+            string filler( 4000, 'x' );
+            vector<BSONObj> batch;
+            for( int i = 0; i < _docs; i++ ) {
+                batch.push_back( BSON( "_id" << i << "filler" << filler ) );
+                if( batch.size() == 1000 ) {
+                    client().insert( ns(), batch );
+                    batch.clear();
+                }
+            }
+            client().insert( ns(), batch );
+        }
+        void timed() {
+            auto_ptr<DBClientCursor> c = client().query( ns(), Query() );
+            verify( c->itcount() == _docs );
+        }
+        string timed2(DBClientBase& c) {
+            auto_ptr<DBClientCursor> cursor = c.query( ns(), Query() );
+            verify( cursor->itcount() == _docs );
+            return "large-batch-query-remote";
+        }
+    private:
+        int _docs;
+    };
+
     template <typename T>
     class MoreIndexes : public T {
     public:
@@ -1140,6 +1326,10 @@ namespace PerfTests {
                 add< mutexspeed >();
                 add< simplemutexspeed >();
                 add< spinlockspeed >();
+                add< ThreadPoolDispatch<1> >();
+                add< TaskExecutorDispatch<1> >();
+                add< ThreadPoolDispatch<dispatchBatch> >();
+                add< TaskExecutorDispatch<dispatchBatch> >();
 #ifdef RUNCOMPARESWAP
                 add< casspeed >();
 #endif
@@ -1159,6 +1349,9 @@ namespace PerfTests {
                 add< Update1 >();
                 add< MoreIndexes<Update1> >();
                 add< InsertBig >();
+                add< GeoS2 >();
+                add< TextSearch >();
+                add< LargeBatchQuery >();
             }
         }
     } myall;
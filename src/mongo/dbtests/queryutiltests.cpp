@@ -19,6 +19,7 @@
 
 #include "pch.h"
 #include "../db/queryutil.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/queryoptimizer.h"
 #include "../db/querypattern.h"
 #include "../db/instance.h"
@@ -530,6 +531,25 @@ namespace QueryUtilTests {
             }
         };
 
+        /** Adjacent prefix regexes in an $in, as in s2 coverings, merge into one interval. */
+        class InRegexUnion {
+        public:
+            void run() {
+                FieldRangeSet f( "", fromjson( "{a:{$in:[/^1f3/,/^1f0/,'1f',/^1f1/,/^1f2/,/^2f/]}}" ),
+                                 true, true );
+                const vector<FieldInterval> &intervals = f.range( "a" ).intervals();
+                ASSERT_EQUALS( 3U, intervals.size() );
+                ASSERT_EQUALS( "1f", intervals[ 0 ]._lower._bound.String() );
+                ASSERT( intervals[ 0 ].equality() );
+                ASSERT_EQUALS( "1f0", intervals[ 1 ]._lower._bound.String() );
+                ASSERT( intervals[ 1 ]._lower._inclusive );
+                ASSERT_EQUALS( "1f4", intervals[ 1 ]._upper._bound.String() );
+                ASSERT( !intervals[ 1 ]._upper._inclusive );
+                ASSERT_EQUALS( "2f", intervals[ 2 ]._lower._bound.String() );
+                ASSERT( !f.range( "a" ).mustBeExactMatchRepresentation() );
+            }
+        };
+
         /** Check union of two non overlapping ranges. */
         class BoundUnion {
         public:
@@ -1820,6 +1840,37 @@ namespace QueryUtilTests {
             }
         };
 
+        /** Point intervals on a hashed index field are mapped to the hashes of the points. */
+        class HashedField {
+        public:
+            void run() {
+                IndexSpec indexSpec( BSON( "t" << 1 << "a" << "hashed" ) );
+                long long h1 = hashOf( 1 );
+                long long h2 = hashOf( 2 );
+
+                FieldRangeSet points( "", fromjson( "{t:5,a:{$in:[1,2]}}" ), true, true );
+                FieldRangeVector pointVector( points, indexSpec, 1 );
+                ASSERT_EQUALS( BSON( "" << 5 << "" << min( h1, h2 ) ), pointVector.startKey() );
+                ASSERT_EQUALS( BSON( "" << 5 << "" << max( h1, h2 ) ), pointVector.endKey() );
+                ASSERT_EQUALS( 2U, pointVector.size() );
+                ASSERT( !pointVector.hasAllIndexedRanges() );
+
+                FieldRangeSet range( "", fromjson( "{t:5,a:{$gt:1}}" ), true, true );
+                FieldRangeVector rangeVector( range, indexSpec, 1 );
+                ASSERT_EQUALS( BSON( "" << 5 << "" << MINKEY ), rangeVector.startKey() );
+                ASSERT_EQUALS( BSON( "" << 5 << "" << MAXKEY ), rangeVector.endKey() );
+                ASSERT( !rangeVector.hasAllIndexedRanges() );
+
+                FieldRangeSet prefix( "", fromjson( "{t:5}" ), true, true );
+                FieldRangeVector prefixVector( prefix, indexSpec, 1 );
+                ASSERT( prefixVector.hasAllIndexedRanges() );
+            }
+        private:
+            static long long hashOf( int value ) {
+                return BSONElementHasher::hash64( BSON( "" << value ).firstElement(), 0 );
+            }
+        };
+
     } // namespace FieldRangeVectorTests
     
     // These are currently descriptive, not normative tests.  SERVER-5450
@@ -2661,6 +2712,7 @@ namespace QueryUtilTests {
             add<FieldRangeTests::QueryPatternOptimizedBounds>();
             add<FieldRangeTests::NoWhere>();
             add<FieldRangeTests::Numeric>();
+            add<FieldRangeTests::InRegexUnion>();
             add<FieldRangeTests::InLowerBound>();
             add<FieldRangeTests::InUpperBound>();
             add<FieldRangeTests::BoundUnion>();
@@ -2795,6 +2847,7 @@ namespace QueryUtilTests {
             add<FieldRangeSetPairTests::BestIndexForPatterns>();
             add<FieldRangeVectorTests::ToString>();
             add<FieldRangeVectorTests::HasAllIndexedRanges>();
+            add<FieldRangeVectorTests::HashedField>();
             add<FieldRangeVectorIteratorTests::AdvanceToNextIntervalEquality>();
             add<FieldRangeVectorIteratorTests::AdvanceToNextIntervalExclusiveInequality>();
             add<FieldRangeVectorIteratorTests::AdvanceToNextIntervalEqualityReverse>();
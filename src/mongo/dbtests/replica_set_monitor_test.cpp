@@ -572,6 +572,82 @@ namespace {
         ASSERT(!host.empty());
     }
 
+    TEST(ReplSetMonitorReadPref, SecOnlyPrefersLowerReadLatency) {
+        vector<ReplicaSetMonitor::Node> nodes =
+                NodeSetFixtures::getThreeMemberWithTags();
+        TagSet tags(TagSetFixtures::getDefaultSet());
+        HostAndPort lastHost = nodes[2].addr;
+
+        // round robin would pick "a" next, but it has been serving reads slowly
+        nodes[0].readLatencyMicros = 5000;
+        nodes[2].readLatencyMicros = 100;
+
+        bool isPrimarySelected = false;
+        HostAndPort host = ReplicaSetMonitor::selectNode(nodes,
+            mongo::ReadPreference_SecondaryOnly, &tags, 3, &lastHost,
+            &isPrimarySelected);
+
+        ASSERT(!isPrimarySelected);
+        ASSERT_EQUALS("c", host.host());
+        ASSERT_EQUALS("c", lastHost.host());
+    }
+
+    TEST(ReplSetMonitorReadPref, SecOnlyAvoidsNodeWithReadsInFlight) {
+        vector<ReplicaSetMonitor::Node> nodes =
+                NodeSetFixtures::getThreeMemberWithTags();
+        TagSet tags(TagSetFixtures::getDefaultSet());
+        HostAndPort lastHost = nodes[2].addr;
+
+        nodes[0].inFlightReads = 10;
+
+        bool isPrimarySelected = false;
+        HostAndPort host = ReplicaSetMonitor::selectNode(nodes,
+            mongo::ReadPreference_SecondaryOnly, &tags, 3, &lastHost,
+            &isPrimarySelected);
+
+        ASSERT(!isPrimarySelected);
+        ASSERT_EQUALS("c", host.host());
+    }
+
+    TEST(ReplSetMonitorReadPref, SecOnlyEqualCostKeepsRoundRobin) {
+        vector<ReplicaSetMonitor::Node> nodes =
+                NodeSetFixtures::getThreeMemberWithTags();
+        TagSet tags(TagSetFixtures::getDefaultSet());
+        HostAndPort lastHost = nodes[2].addr;
+
+        nodes[0].readLatencyMicros = 100;
+        nodes[2].readLatencyMicros = 100;
+
+        bool isPrimarySelected = false;
+        HostAndPort host = ReplicaSetMonitor::selectNode(nodes,
+            mongo::ReadPreference_SecondaryOnly, &tags, 3, &lastHost,
+            &isPrimarySelected);
+
+        ASSERT(!isPrimarySelected);
+        ASSERT_EQUALS("a", host.host());
+    }
+
+    TEST(ReplSetMonitorReadPref, SecOnlyNonLocalIgnoresReadLatency) {
+        vector<ReplicaSetMonitor::Node> nodes =
+                NodeSetFixtures::getThreeMemberWithTags();
+        TagSet tags(TagSetFixtures::getDefaultSet());
+        HostAndPort lastHost = nodes[2].addr;
+
+        // "a" is the only local secondary, so it wins even though it is slower
+        nodes[0].pingTimeMillis = 1;
+        nodes[2].pingTimeMillis = 50;
+        nodes[0].readLatencyMicros = 5000;
+        nodes[2].readLatencyMicros = 100;
+
+        bool isPrimarySelected = false;
+        HostAndPort host = ReplicaSetMonitor::selectNode(nodes,
+            mongo::ReadPreference_SecondaryOnly, &tags, 3, &lastHost,
+            &isPrimarySelected);
+
+        ASSERT(!isPrimarySelected);
+        ASSERT_EQUALS("a", host.host());
+    }
+
     TEST(ReplSetMonitorReadPref, PriOnlyWithTagsNoMatch) {
         vector<ReplicaSetMonitor::Node> nodes =
                 NodeSetFixtures::getThreeMemberWithTags();
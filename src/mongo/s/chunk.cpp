@@ -20,6 +20,7 @@
 
 #include "mongo/client/connpool.h"
 #include "mongo/client/dbclientcursor.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/queryutil.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/chunk.h"
@@ -53,7 +54,8 @@ namespace mongo {
     bool Chunk::ShouldAutoSplit = true;
 
     Chunk::Chunk(const ChunkManager * manager, BSONObj from)
-        : _manager(manager), _lastmod(0, OID()), _dataWritten(mkDataWritten())
+        : _manager(manager), _lastmod(0, OID()), _dataWritten(mkDataWritten()),
+          _sampleMutex("Chunk::_keySample"), _keySample(KeySample::DefaultCapacity, time(0))
     {
         string ns = from.getStringField(ChunkFields::ns().c_str());
         _shard.reset(from.getStringField(ChunkFields::shard().c_str()));
@@ -76,7 +78,8 @@ namespace mongo {
     }
 
     Chunk::Chunk(const ChunkManager * info , const BSONObj& min, const BSONObj& max, const Shard& shard, ShardChunkVersion lastmod)
-        : _manager(info), _min(min), _max(max), _shard(shard), _lastmod(lastmod), _jumbo(false), _dataWritten(mkDataWritten())
+        : _manager(info), _min(min), _max(max), _shard(shard), _lastmod(lastmod), _jumbo(false), _dataWritten(mkDataWritten()),
+          _sampleMutex("Chunk::_keySample"), _keySample(KeySample::DefaultCapacity, time(0))
     {}
 
     int Chunk::mkDataWritten() {
@@ -165,6 +168,27 @@ namespace mongo {
         conn->done();
     }
 
+    void Chunk::pickSampledMedianKey( BSONObj& medianKey ) const {
+        BSONObj median;
+        {
+            SimpleMutex::scoped_lock lk( _sampleMutex );
+            if ( _keySample.size() < MinSampledKeysForSplit )
+                return;
+            median = _keySample.median();
+        }
+
+        // the chunk boundaries may have moved since the keys were sampled
+        if ( ! containsPoint( median ) || _min.woCompare( median ) == 0 )
+            return;
+
+        medianKey = median;
+    }
+
+    void Chunk::noteKeyWritten( const BSONObj& key ) const {
+        SimpleMutex::scoped_lock lk( _sampleMutex );
+        _keySample.add( key );
+    }
+
     void Chunk::pickSplitVector( vector<BSONObj>& splitPoints , int chunkSize /* bytes */, int maxPoints, int maxObjs ) const {
         // Ask the mongod holding this chunk to figure out the split points.
         scoped_ptr<ScopedDbConnection> conn(
@@ -216,9 +240,16 @@ namespace mongo {
 
         }
         else {
-            // if forcing a split, use the chunk's median key
+            // if forcing a split, use the chunk's median key. Prefer the median of the keys this
+            // mongos has seen written to the chunk, which avoids having the shard walk the whole
+            // index range (twice) to find it.
             BSONObj medianKey;
-            pickMedianKey( medianKey );
+            pickSampledMedianKey( medianKey );
+            if ( medianKey.isEmpty() )
+                pickMedianKey( medianKey );
+            else
+                LOG(1) << "using sampled median key " << medianKey << " to split " << toString() << endl;
+
             if ( ! medianKey.isEmpty() )
                 splitPoint.push_back( medianKey );
         }
@@ -1138,6 +1169,72 @@ namespace mongo {
         }
     }
 
+    bool ChunkManager::splitInQueryByShard( const BSONObj& query ,
+                                            map<Shard,BSONObj>& shardQueries ) const {
+        BSONObj keyPattern = _key.key();
+        BSONElement keyField = keyPattern.firstElement();
+        bool hashed = str::equals( keyField.valuestrsafe() , "hashed" );
+
+        BSONElement inElt = query[ keyField.fieldName() ];
+        if ( inElt.type() != Object )
+            return false;
+        BSONObj inSpec = inElt.embeddedObject();
+        if ( inSpec.nFields() != 1 || ! str::equals( inSpec.firstElementFieldName() , "$in" ) ||
+             inSpec.firstElement().type() != Array )
+            return false;
+
+        map< Shard, vector<BSONElement> > valuesByShard;
+        BSONForEach( value , inSpec.firstElement().embeddedObject() ) {
+            // these match more than the single key they would route to
+            if ( value.type() == RegEx || value.type() == Array ||
+                 value.type() == jstNULL || value.type() == Undefined )
+                return false;
+
+            BSONObjBuilder minB;
+            BSONObjBuilder maxB;
+            BSONObjIterator i( keyPattern );
+            i.next();
+            if ( hashed ) {
+                long long h = BSONElementHasher::hash64( value ,
+                                                         BSONElementHasher::DEFAULT_HASH_SEED );
+                minB.append( keyField.fieldName() , h );
+                maxB.append( keyField.fieldName() , h );
+            }
+            else {
+                minB.appendAs( value , keyField.fieldName() );
+                maxB.appendAs( value , keyField.fieldName() );
+            }
+            while ( i.more() ) {
+                BSONElement e = i.next();
+                minB.appendMinKey( e.fieldName() );
+                maxB.appendMaxKey( e.fieldName() );
+            }
+
+            set<Shard> shards;
+            getShardsForRange( shards , minB.obj() , maxB.obj() , false );
+            for ( set<Shard>::const_iterator s = shards.begin(); s != shards.end(); ++s )
+                valuesByShard[ *s ].push_back( value );
+        }
+
+        for ( map< Shard, vector<BSONElement> >::const_iterator s = valuesByShard.begin();
+              s != valuesByShard.end(); ++s ) {
+            BSONObjBuilder b;
+            BSONForEach( e , query ) {
+                if ( ! str::equals( e.fieldName() , keyField.fieldName() ) ) {
+                    b.append( e );
+                    continue;
+                }
+                BSONArrayBuilder valuesB;
+                for ( unsigned j = 0; j < s->second.size(); j++ )
+                    valuesB.append( s->second[ j ] );
+                b.append( e.fieldName() , BSON( "$in" << valuesB.arr() ) );
+            }
+            shardQueries[ s->first ] = b.obj();
+        }
+
+        return true;
+    }
+
     void ChunkManager::getShardsForRange(set<Shard>& shards, const BSONObj& min, const BSONObj& max, bool fullKeyReq ) const {
 
         if( fullKeyReq ){
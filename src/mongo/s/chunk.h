@@ -23,6 +23,7 @@
 #include "mongo/bson/util/atomic_int.h"
 #include "mongo/client/distlock.h"
 #include "mongo/s/cluster_constants.h"
+#include "mongo/s/key_sample.h"
 #include "mongo/s/shard.h"
 #include "mongo/s/shardkey.h"
 #include "mongo/s/util.h"
@@ -107,6 +108,12 @@ namespace mongo {
          */
         bool splitIfShould( long dataWritten ) const;
 
+        /**
+         * Records the shard key of a document written to this chunk in the chunk's key sample.
+         * The sample is used to pick split points without an index scan on the shard.
+         */
+        void noteKeyWritten( const BSONObj& key ) const;
+
         /**
          * Splits this chunk at a non-specificed split key to be chosen by the mongod holding this chunk.
          *
@@ -133,6 +140,15 @@ namespace mongo {
          */
         void pickMedianKey( BSONObj& medianKey ) const;
 
+        /**
+         * Picks the median of the shard keys sampled by this mongos for writes to this chunk.
+         * Does not contact the shard.
+         *
+         * @param medianKey the sampled median strictly inside (min, max), or empty if the
+         *                  sample is too small to be trusted
+         */
+        void pickSampledMedianKey( BSONObj& medianKey ) const;
+
         /**
          * @param splitPoints vector to be filled in
          * @param chunkSize chunk size to target in bytes
@@ -183,6 +199,9 @@ namespace mongo {
         static int MaxObjectPerChunk;
         static bool ShouldAutoSplit;
 
+        // fewest sampled keys for which the sampled median is preferred over a splitVector scan
+        static const size_t MinSampledKeysForSplit = 32;
+
         //
         // accessors and helpers
         //
@@ -216,6 +235,10 @@ namespace mongo {
 
         mutable long _dataWritten;
 
+        // shard keys of writes routed to this chunk by this mongos, guarded by _sampleMutex
+        mutable SimpleMutex _sampleMutex;
+        mutable KeySample _keySample;
+
         // methods, etc..
 
         /** Returns the highest or lowest existing value in the shard-key space.
@@ -391,6 +414,18 @@ namespace mongo {
         ChunkPtr findChunkOnServer( const Shard& shard ) const;
 
         void getShardsForQuery( set<Shard>& shards , const BSONObj& query ) const;
+
+        /**
+         * If 'query' constrains the leading shard key field with a top level $in, splits the
+         * $in values by the shard owning them, so each shard is only asked for its own values.
+         * Hashed shard keys are handled by hashing each value before routing it.
+         *
+         * @param shardQueries filled with, for each shard, 'query' with the $in list reduced
+         *        to the values that shard owns
+         * @return false, leaving 'shardQueries' empty, if the query has no such $in or one of
+         *         its values (e.g. a regex) cannot be routed to a single point
+         */
+        bool splitInQueryByShard( const BSONObj& query , map<Shard,BSONObj>& shardQueries ) const;
         void getAllShards( set<Shard>& all ) const;
         /** @param shards set to the shards covered by the interval [min, max], see SERVER-4791 */
         void getShardsForRange(set<Shard>& shards, const BSONObj& min, const BSONObj& max, bool fullKeyReq = true) const;
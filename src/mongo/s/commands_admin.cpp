@@ -382,36 +382,35 @@ namespace mongo {
                     return false;
                 }
 
-                // Currently the allowable shard keys are either
-                // i) a hashed single field, e.g. { a : "hashed" }, or
-                // ii) a compound list of ascending fields, e.g. { a : 1 , b : 1 }
-                if ( proposedKey.firstElementType() == mongo::String ) {
-                    // case i)
-                    if ( !str::equals( proposedKey.firstElement().valuestrsafe() , "hashed" ) ) {
-                        errmsg = "unrecognized string: " + proposedKey.firstElement().str();
-                        return false;
-                    }
-                    if ( proposedKey.nFields() > 1 ) {
-                        errmsg = "hashed shard keys currently only support single field keys";
-                        return false;
-                    }
-                    if ( cmdObj["unique"].trueValue() ) {
-                        // it's possible to ensure uniqueness on the hashed field by
-                        // declaring an additional (non-hashed) unique index on the field,
-                        // but the hashed shard key itself should not be declared unique
-                        errmsg = "hashed shard keys cannot be declared unique.";
-                        return false;
-                    }
-                } else {
-                    // case ii)
-                    BSONForEach(e, proposedKey) {
-                        if (!e.isNumber() || e.number() != 1.0) {
-                            errmsg = str::stream() << "Unsupported shard key pattern.  Pattern must"
-                                                   << " either be a single hashed field, or a list"
-                                                   << " of ascending fields.";
+                // Currently the allowable shard keys are a compound list of ascending fields,
+                // e.g. { a : 1 , b : 1 }, of which at most one may instead be hashed,
+                // e.g. { a : "hashed" } or { tenant : 1 , userId : "hashed" }
+                int hashedFields = 0;
+                BSONForEach(e, proposedKey) {
+                    if ( e.type() == mongo::String ) {
+                        if ( !str::equals( e.valuestrsafe() , "hashed" ) ) {
+                            errmsg = "unrecognized string: " + e.str();
                             return false;
                         }
+                        hashedFields++;
                     }
+                    else if (!e.isNumber() || e.number() != 1.0) {
+                        errmsg = str::stream() << "Unsupported shard key pattern.  Pattern must"
+                                               << " be a list of ascending fields, at most one"
+                                               << " of which may be hashed.";
+                        return false;
+                    }
+                }
+                if ( hashedFields > 1 ) {
+                    errmsg = "hashed shard keys currently only support one hashed field";
+                    return false;
+                }
+                if ( hashedFields > 0 && cmdObj["unique"].trueValue() ) {
+                    // it's possible to ensure uniqueness on the hashed field by
+                    // declaring an additional (non-hashed) unique index on the field,
+                    // but the hashed shard key itself should not be declared unique
+                    errmsg = "hashed shard keys cannot be declared unique.";
+                    return false;
                 }
 
                 if ( ns.find( ".system." ) != string::npos ) {
@@ -266,6 +266,12 @@ namespace mongo {
             RepairDatabaseCmd() :  RunOnAllShardsCommand("repairDatabase") {}
         } repairDatabaseCmd;
 
+        class WorkingSetStatsCmd : public RunOnAllShardsCommand {
+        public:
+            // what matters is which shard's RAM it is, so the shards' results aren't combined
+            WorkingSetStatsCmd() :  RunOnAllShardsCommand("workingSetStats") {}
+        } workingSetStatsCmd;
+
         class DBStatsCmd : public RunOnAllShardsCommand {
         public:
             DBStatsCmd() :  RunOnAllShardsCommand("dbStats", "dbstats") {}
@@ -622,7 +628,8 @@ namespace mongo {
                              str::equals( e.fieldName() , "ok" ) || 
                              str::equals( e.fieldName() , "avgObjSize" ) ||
                              str::equals( e.fieldName() , "lastExtentSize" ) ||
-                             str::equals( e.fieldName() , "paddingFactor" ) ) {
+                             str::equals( e.fieldName() , "paddingFactor" ) ||
+                             str::equals( e.fieldName() , "workingSet" ) ) { // per shard, in shards
                             continue;
                         }
                         else if ( str::equals( e.fieldName() , "count" ) ||
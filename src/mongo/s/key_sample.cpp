@@ -0,0 +1,62 @@
+// @file key_sample.cpp
+
+/**
+ *    Copyright (C) 2012 10gen Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mongo/s/key_sample.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+    KeySample::KeySample( size_t capacity , int64_t seed )
+        : _capacity( capacity ), _seen( 0 ), _random( seed ) {
+        verify( _capacity > 0 );
+        _keys.reserve( _capacity );
+    }
+
+    void KeySample::add( const BSONObj& key ) {
+        _seen++;
+
+        if ( _keys.size() < _capacity ) {
+            _keys.push_back( key.getOwned() );
+            return;
+        }
+
+        // keep the new key with probability capacity / seen, evicting a random slot
+        long long slot = _random.nextInt64() % _seen;
+        if ( slot < 0 )
+            slot = -slot;
+        if ( slot < static_cast<long long>( _capacity ) )
+            _keys[ static_cast<size_t>( slot ) ] = key.getOwned();
+    }
+
+    void KeySample::clear() {
+        _seen = 0;
+        _keys.clear();
+    }
+
+    BSONObj KeySample::median() const {
+        if ( _keys.empty() )
+            return BSONObj();
+
+        std::vector<BSONObj> sorted( _keys );
+        std::vector<BSONObj>::iterator mid = sorted.begin() + sorted.size() / 2;
+        std::nth_element( sorted.begin() , mid , sorted.end() , BSONObjCmp() );
+        return *mid;
+    }
+
+}
@@ -0,0 +1,70 @@
+// @file key_sample.h
+
+/**
+ *    Copyright (C) 2012 10gen Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/platform/cstdint.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+
+    /**
+     * A fixed size, uniform random sample of the keys offered to it (reservoir sampling,
+     * "algorithm R"). mongos keeps one per chunk, fed with the shard keys of the documents it
+     * routes there, so that a split point can be picked without asking the shard to walk the
+     * chunk's index range.
+     *
+     * Not thread safe; callers serialize access.
+     */
+    class KeySample {
+    public:
+        static const size_t DefaultCapacity = 128;
+
+        explicit KeySample( size_t capacity = DefaultCapacity , int64_t seed = 0 );
+
+        /** offers 'key' to the sample; it is kept (owned) with probability capacity / seen */
+        void add( const BSONObj& key );
+
+        /** forgets all keys seen so far */
+        void clear();
+
+        /** @return number of keys currently retained, at most the capacity */
+        size_t size() const { return _keys.size(); }
+
+        /** @return number of keys ever offered since construction or the last clear() */
+        long long seen() const { return _seen; }
+
+        size_t capacity() const { return _capacity; }
+
+        /**
+         * @return the median of the retained keys in ascending woCompare order,
+         *         or an empty object if the sample is empty
+         */
+        BSONObj median() const;
+
+    private:
+        const size_t _capacity;
+        long long _seen;
+        std::vector<BSONObj> _keys;
+        PseudoRandom _random;
+    };
+
+}
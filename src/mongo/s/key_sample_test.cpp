@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2012 10gen Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mongo/db/jsobj.h"
+#include "mongo/s/key_sample.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+    using mongo::BSONObj;
+    using mongo::KeySample;
+
+    TEST(KeySample, EmptyHasNoMedian) {
+        KeySample sample;
+        ASSERT_EQUALS(sample.size(), 0U);
+        ASSERT_EQUALS(sample.seen(), 0);
+        ASSERT_TRUE(sample.median().isEmpty());
+    }
+
+    TEST(KeySample, KeepsEverythingBelowCapacity) {
+        KeySample sample(10);
+        for (int i = 0; i < 5; i++) {
+            sample.add(BSON("a" << i));
+        }
+        ASSERT_EQUALS(sample.size(), 5U);
+        ASSERT_EQUALS(sample.seen(), 5);
+        ASSERT_EQUALS(sample.median(), BSON("a" << 2));
+    }
+
+    TEST(KeySample, SizeIsBoundedByCapacity) {
+        KeySample sample(16);
+        for (int i = 0; i < 10000; i++) {
+            sample.add(BSON("a" << i));
+        }
+        ASSERT_EQUALS(sample.size(), 16U);
+        ASSERT_EQUALS(sample.seen(), 10000);
+    }
+
+    TEST(KeySample, MedianIsRepresentative) {
+        KeySample sample(KeySample::DefaultCapacity, 12345);
+        for (int i = 0; i < 100000; i++) {
+            sample.add(BSON("a" << i));
+        }
+        // with 128 uniform samples the median lands well inside the middle half
+        int median = sample.median()["a"].numberInt();
+        ASSERT_GREATER_THAN(median, 25000);
+        ASSERT_LESS_THAN(median, 75000);
+    }
+
+    TEST(KeySample, ClearResets) {
+        KeySample sample(4);
+        for (int i = 0; i < 10; i++) {
+            sample.add(BSON("a" << i));
+        }
+        sample.clear();
+        ASSERT_EQUALS(sample.size(), 0U);
+        ASSERT_EQUALS(sample.seen(), 0);
+        ASSERT_TRUE(sample.median().isEmpty());
+    }
+
+}
@@ -463,7 +463,8 @@ namespace mongo {
                     // Sharded insert
                     //
 
-                    ChunkPtr chunk = group->manager->findChunkForDoc(o);
+                    BSONObj shardKey = group->manager->getShardKey().extractKey(o);
+                    ChunkPtr chunk = group->manager->findIntersectingChunk(shardKey);
 
                     if (!group->shard) {
                         group->shard.reset(new Shard(chunk->getShard()));
@@ -479,6 +480,7 @@ namespace mongo {
                     o = group->manager->getShardKey().moveToFront(o);
                     group->inserts.push_back(o);
                     group->chunkData[chunk] += objSize;
+                    chunk->noteKeyWritten(shardKey);
                 }
                 else {
 
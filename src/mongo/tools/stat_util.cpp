@@ -157,6 +157,9 @@ namespace mongo {
             _append( result , "idx miss %" , 8 , percent( "indexCounters.btree.accesses" , "indexCounters.btree.misses" , a , b ) );
         }
 
+        if ( a["opLatencies"].isABSONObj() && b["opLatencies"].isABSONObj() )
+            _appendLatency( result , a["opLatencies"].Obj() , b["opLatencies"].Obj() );
+
         if ( b.getFieldDotted( "globalLock.currentQueue" ).type() == Object ) {
             int r = b.getFieldDotted( "globalLock.currentQueue.readers" ).numberInt();
             int w = b.getFieldDotted( "globalLock.currentQueue.writers" ).numberInt();
@@ -298,6 +301,69 @@ namespace mongo {
         _append( result , name , width , ss.str() );
     }
 
+    void StatUtil::_appendLatency( BSONObjBuilder& result , const BSONObj& a , const BSONObj& b ) {
+        // all op types together, over the interval
+        LatencyDiff latency;
+        BSONForEach( e , b ) {
+            if ( e.isABSONObj() && a[e.fieldName()].isABSONObj() )
+                latency.add( a[e.fieldName()].Obj() , e.Obj() );
+        }
+
+        _append( result , "p50" , 6 , LatencyDiff::format( latency.percentile( 0.5 ) ) );
+        _append( result , "p99" , 6 , LatencyDiff::format( latency.percentile( 0.99 ) ) );
+        _append( result , "p999" , 6 , LatencyDiff::format( latency.percentile( 0.999 ) ) );
+    }
+
+    void LatencyDiff::add( const BSONObj& older , const BSONObj& newer ) {
+        if ( ! newer["buckets"].isABSONObj() )
+            return;
+
+        map<long long,long long> before;
+        if ( older["buckets"].isABSONObj() ) {
+            BSONForEach( e , older["buckets"].Obj() ) {
+                BSONObj bucket = e.Obj();
+                before[ bucket[0].numberLong() ] = bucket[1].numberLong();
+            }
+        }
+
+        BSONForEach( e , newer["buckets"].Obj() ) {
+            BSONObj bucket = e.Obj();
+            long long bound = bucket[0].numberLong();
+            long long n = bucket[1].numberLong() - before[bound];
+            // negative after a collection is dropped and recreated
+            if ( n <= 0 )
+                continue;
+            _buckets[bound] += n;
+            _count += n;
+        }
+    }
+
+    long long LatencyDiff::percentile( double p ) const {
+        if ( _count == 0 )
+            return 0;
+
+        long long rank = max( 1LL , (long long)ceil( p * _count ) );
+        long long seen = 0;
+        for ( map<long long,long long>::const_iterator i = _buckets.begin(); i != _buckets.end(); ++i ) {
+            seen += i->second;
+            if ( seen >= rank )
+                return i->first;
+        }
+        return _buckets.rbegin()->first;
+    }
+
+    string LatencyDiff::format( long long micros ) {
+        if ( micros < 1000 )
+            return str::stream() << micros << "us";
+
+        stringstream ss;
+        if ( micros < 1000 * 1000 )
+            ss << setprecision(3) << micros / 1000.0 << "ms";
+        else
+            ss << setprecision(3) << micros / ( 1000.0 * 1000 ) << "s";
+        return ss.str();
+    }
+
     NamespaceStats StatUtil::parseServerStatusLocks( const BSONObj& serverStatus ) {
         NamespaceStats stats;
 
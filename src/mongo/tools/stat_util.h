@@ -23,6 +23,28 @@
 
 namespace mongo {
 
+    /**
+     * The latencies recorded between two samples of histograms, as appended by
+     * LatencyHistogram::append on the server.  Several histograms can be added up.
+     */
+    class LatencyDiff {
+    public:
+        LatencyDiff() : _count(0) {}
+
+        void add( const BSONObj& older , const BSONObj& newer );
+
+        long long count() const { return _count; }
+
+        /** @return micros, or 0 if nothing was recorded */
+        long long percentile( double p ) const;
+
+        /** formats micros as "123us" , "4.5ms" or "1.2s" */
+        static string format( long long micros );
+
+    private:
+        map<long long,long long> _buckets; // upper bound -> count
+        long long _count;
+    };
 
     struct NamespaceInfo {
         string ns;
@@ -30,6 +52,8 @@ namespace mongo {
         // these need to be in millis
         long long read;
         long long write;
+
+        BSONObj latency; // from top, empty for older servers or locks
         
         string toString() const {
             stringstream ss;
@@ -44,11 +68,14 @@ namespace mongo {
         
         long long read;
         long long write;
+
+        LatencyDiff latency;
         
         NamespaceDiff( NamespaceInfo prev , NamespaceInfo now ) {
             ns = prev.ns;
             read = now.read - prev.read;
             write = now.write - prev.write;
+            latency.add( prev.latency , now.latency );
         }
         
         long long total() const { return read + write; }
@@ -96,6 +123,8 @@ namespace mongo {
 
         void _appendNet( BSONObjBuilder& result , const string& name , double diff );
 
+        void _appendLatency( BSONObjBuilder& result , const BSONObj& a , const BSONObj& b );
+
         template<typename T>
         void _append( BSONObjBuilder& result , const string& name , unsigned width , const T& t ) {
             if ( name.size() > width )
@@ -99,6 +99,8 @@ namespace mongo {
                 s.ns = e.fieldName();
                 s.read = e.Obj()["readLock"].Obj()["time"].numberLong() / 1000;
                 s.write = e.Obj()["writeLock"].Obj()["time"].numberLong() / 1000;
+                if ( e.Obj()["latency"].isABSONObj() )
+                    s.latency = e.Obj()["latency"].Obj().getOwned();
             }
 
             return stats;
@@ -130,8 +132,13 @@ namespace mongo {
                  << setw(longest) << ( useLocks() ? "db" : "ns" )
                  << setw(numberWidth+2) << "total"
                  << setw(numberWidth+2) << "read"
-                 << setw(numberWidth+2) << "write"
-                 << "\t\t" << terseCurrentTime()
+                 << setw(numberWidth+2) << "write";
+            if ( ! useLocks() ) {
+                cout << setw(numberWidth) << "p50"
+                     << setw(numberWidth) << "p99"
+                     << setw(numberWidth) << "p999";
+            }
+            cout << "\t\t" << terseCurrentTime()
                  << endl;
             for ( int i=data.size()-1; i>=0 && data.size() - i < 10 ; i-- ) {
                 
@@ -141,8 +148,14 @@ namespace mongo {
                 cout << setw(longest) << data[i].ns 
                      << setw(numberWidth) << setprecision(3) << data[i].total() << "ms"
                      << setw(numberWidth) << setprecision(3) << data[i].read << "ms"
-                     << setw(numberWidth) << setprecision(3) << data[i].write << "ms"
-                     << endl;
+                     << setw(numberWidth) << setprecision(3) << data[i].write << "ms";
+                if ( ! useLocks() ) {
+                    const LatencyDiff& latency = data[i].latency;
+                    cout << setw(numberWidth) << LatencyDiff::format( latency.percentile( 0.5 ) )
+                         << setw(numberWidth) << LatencyDiff::format( latency.percentile( 0.99 ) )
+                         << setw(numberWidth) << LatencyDiff::format( latency.percentile( 0.999 ) );
+                }
+                cout << endl;
             }
 
         }
@@ -0,0 +1,186 @@
+/*
+ *    Copyright (C) 2012 10gen Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mongo/util/arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/threadlocal.h"
+
+namespace mongo {
+
+    TSP_DECLARE(Arena, threadArena)
+    TSP_DEFINE(Arena, threadArena)
+
+    namespace {
+        const size_t Alignment = 16;
+
+        inline size_t aligned( size_t bytes ) {
+            return ( bytes + Alignment - 1 ) & ~( Alignment - 1 );
+        }
+
+        /** Chunk headers are padded so the data after them stays aligned. */
+        const size_t ChunkHeaderSize = aligned( sizeof( void* ) + sizeof( size_t ) );
+    } // namespace
+
+    Arena::Arena() :
+        _chunks(),
+        _next(),
+        _end(),
+        _last(),
+        _allocations(),
+        _bytesAllocated(),
+        _inOp() {
+    }
+
+    Arena::~Arena() {
+        while ( _chunks ) {
+            Chunk* next = _chunks->next;
+            free( _chunks );
+            _chunks = next;
+        }
+    }
+
+    char* Arena::newChunk( size_t bytes ) {
+        size_t size = std::max( bytes, static_cast<size_t>( ChunkSize ) );
+        Chunk* chunk = static_cast<Chunk*>( malloc( ChunkHeaderSize + size ) );
+        if ( chunk == NULL )
+            msgasserted( 16495, "out of memory Arena::newChunk" );
+        chunk->size = size;
+        char* data = reinterpret_cast<char*>( chunk ) + ChunkHeaderSize;
+
+        if ( size > ChunkSize && _chunks ) {
+            // an outsized allocation gets a chunk to itself, behind the one being carved up
+            chunk->next = _chunks->next;
+            _chunks->next = chunk;
+            return data;
+        }
+        chunk->next = _chunks;
+        _chunks = chunk;
+        _next = data + bytes;
+        _end = data + size;
+        return data;
+    }
+
+    void* Arena::allocate( size_t bytes ) {
+        bytes = aligned( bytes );
+        _allocations++;
+        _bytesAllocated += bytes;
+
+        if ( static_cast<size_t>( _end - _next ) >= bytes ) {
+            _last = _next;
+            _next += bytes;
+            return _last;
+        }
+        char* data = newChunk( bytes );
+        // an outsized chunk may not be the one carved from, so it can't be extended
+        _last = ( data + bytes == _next ) ? data : NULL;
+        return data;
+    }
+
+    void* Arena::reallocate( void* p, size_t oldBytes, size_t newBytes ) {
+        if ( p == _last && _last != NULL &&
+             static_cast<size_t>( _end - _last ) >= aligned( newBytes ) ) {
+            _bytesAllocated += aligned( newBytes ) - ( _next - _last );
+            _next = _last + aligned( newBytes );
+            return p;
+        }
+        void* q = allocate( newBytes );
+        memcpy( q, p, std::min( oldBytes, newBytes ) );
+        return q;
+    }
+
+    void Arena::reset() {
+        // keep the most recent ordinary chunk for the next operation
+        Chunk* keep = NULL;
+        while ( _chunks ) {
+            Chunk* next = _chunks->next;
+            if ( keep == NULL && _chunks->size == ChunkSize )
+                keep = _chunks;
+            else
+                free( _chunks );
+            _chunks = next;
+        }
+        _chunks = keep;
+        if ( keep ) {
+            keep->next = NULL;
+            _next = reinterpret_cast<char*>( keep ) + ChunkHeaderSize;
+            _end = _next + keep->size;
+        }
+        else {
+            _next = _end = NULL;
+        }
+        _last = NULL;
+        _allocations = 0;
+        _bytesAllocated = 0;
+    }
+
+    Arena* Arena::current() {
+        Arena* arena = threadArena.get();
+        return arena && arena->_inOp ? arena : NULL;
+    }
+
+    Arena::OpScope::OpScope() : _arena( threadArena.getMake() ) {
+        if ( _arena->_inOp ) {
+            _arena = NULL;
+            return;
+        }
+        _arena->_inOp = true;
+    }
+
+    Arena::OpScope::~OpScope() {
+        if ( _arena ) {
+            _arena->reset();
+            _arena->_inOp = false;
+        }
+    }
+
+    void* ArenaAllocator::Malloc( size_t sz ) {
+        if ( sz <= SZ )
+            return _buf;
+        _arena = Arena::current();
+        _size = sz;
+        if ( _arena )
+            return _arena->allocate( sz );
+        return malloc( sz );
+    }
+
+    void* ArenaAllocator::Realloc( void* p, size_t sz ) {
+        if ( p == _buf ) {
+            if ( sz <= SZ )
+                return _buf;
+            void* d = Malloc( sz );
+            if ( d == NULL )
+                msgasserted( 16496, "out of memory ArenaAllocator::Realloc" );
+            memcpy( d, p, SZ );
+            return d;
+        }
+        size_t oldSize = _size;
+        _size = sz;
+        if ( _arena )
+            return _arena->reallocate( p, oldSize, sz );
+        return realloc( p, sz );
+    }
+
+    void ArenaAllocator::Free( void* p ) {
+        if ( p != _buf && !_arena )
+            free( p );
+    }
+
+} // namespace mongo
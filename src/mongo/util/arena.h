@@ -0,0 +1,126 @@
+/*
+ *    Copyright (C) 2012 10gen Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/util/builder.h"
+
+namespace mongo {
+
+    /**
+     * A bump allocator for memory that lives no longer than one operation.  Allocations are
+     * carved out of chunks and never freed individually; reset() releases them all at once,
+     * keeping one chunk so that the next operation usually doesn't call malloc at all.
+     *
+     * Each thread has an arena, which is current for the duration of an OpScope:
+     *   Arena::OpScope scope;
+     *   ...
+     *   void* p = Arena::current()->allocate( 100 );
+     */
+    class Arena {
+        MONGO_DISALLOW_COPYING(Arena);
+    public:
+        static const size_t ChunkSize = 64 * 1024;
+
+        Arena();
+        ~Arena();
+
+        /** @return 'bytes' of memory, aligned for any type. */
+        void* allocate( size_t bytes );
+
+        /**
+         * @return 'newBytes' holding the first 'oldBytes' of 'p', which was allocated here.
+         * The allocation is extended in place if it was the most recent one and there's room.
+         */
+        void* reallocate( void* p, size_t oldBytes, size_t newBytes );
+
+        /** Releases every allocation. */
+        void reset();
+
+        /** Number of allocations since the last reset(). */
+        long long allocations() const { return _allocations; }
+
+        /** Bytes allocated since the last reset(). */
+        long long bytesAllocated() const { return _bytesAllocated; }
+
+        /** @return the arena of this thread's current operation, or NULL outside of one. */
+        static Arena* current();
+
+        /**
+         * Makes this thread's arena current for the life of the scope, then resets it.  A scope
+         * nested in another one, as for a DBDirectClient request, shares the outer operation's
+         * arena.
+         */
+        class OpScope {
+            MONGO_DISALLOW_COPYING(OpScope);
+        public:
+            OpScope();
+            ~OpScope();
+        private:
+            Arena* _arena; // NULL if nested
+        };
+
+    private:
+        struct Chunk {
+            Chunk* next;
+            size_t size;
+            // followed by 'size' bytes of data
+        };
+
+        char* newChunk( size_t bytes );
+
+        Chunk* _chunks; // most recent first
+        char* _next;    // free space in _chunks
+        char* _end;
+        char* _last;    // most recent allocation, for reallocate()
+
+        long long _allocations;
+        long long _bytesAllocated;
+        bool _inOp;
+    };
+
+    /**
+     * A StackAllocator that takes memory past its inline buffer from the current operation's
+     * arena, or from malloc outside of an operation.  Memory must not be used after the
+     * operation that allocated it ends.
+     */
+    class ArenaAllocator {
+    public:
+        enum { SZ = 512 };
+        ArenaAllocator() : _arena(), _size() {}
+        void* Malloc( size_t sz );
+        void* Realloc( void* p, size_t sz );
+        void Free( void* p );
+    private:
+        char _buf[SZ];
+        Arena* _arena; // where the current out of line buffer came from, if anywhere
+        size_t _size;  // size of the current out of line buffer
+    };
+
+    /**
+     * A StackBufBuilder for buffers that are scratch space of one operation.  Like
+     * StackBufBuilder, its buffer can't be decouple()'d.
+     */
+    class ArenaBufBuilder : public _BufBuilder<ArenaAllocator> {
+    public:
+        ArenaBufBuilder() : _BufBuilder<ArenaAllocator>( ArenaAllocator::SZ ) { }
+        void decouple(); // not allowed. not implemented.
+    };
+
+} // namespace mongo
@@ -0,0 +1,121 @@
+/*
+ *    Copyright (C) 2012 10gen Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mongo/util/arena.h"
+
+#include <cstring>
+#include <string>
+
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+    using mongo::Arena;
+    using mongo::ArenaBufBuilder;
+
+    TEST(Arena, AllocationsAreAlignedAndDistinct) {
+        Arena arena;
+        char* a = static_cast<char*>( arena.allocate( 3 ) );
+        char* b = static_cast<char*>( arena.allocate( 5 ) );
+        ASSERT_EQUALS( 0U, reinterpret_cast<size_t>( a ) % 16 );
+        ASSERT_EQUALS( 0U, reinterpret_cast<size_t>( b ) % 16 );
+        ASSERT( b >= a + 3 );
+        ASSERT_EQUALS( 2, arena.allocations() );
+        ASSERT_EQUALS( 32, arena.bytesAllocated() );
+    }
+
+    TEST(Arena, ChunksAndOutsizedAllocations) {
+        Arena arena;
+        std::memset( arena.allocate( Arena::ChunkSize - 16 ), 1, Arena::ChunkSize - 16 );
+        std::memset( arena.allocate( 64 ), 2, 64 );
+        char* big = static_cast<char*>( arena.allocate( 4 * Arena::ChunkSize ) );
+        std::memset( big, 3, 4 * Arena::ChunkSize );
+        // the outsized chunk doesn't replace the one being carved up
+        char* small = static_cast<char*>( arena.allocate( 16 ) );
+        ASSERT( small < big || small >= big + 4 * Arena::ChunkSize );
+        arena.reset();
+        ASSERT_EQUALS( 0, arena.allocations() );
+        ASSERT_EQUALS( 0, arena.bytesAllocated() );
+        std::memset( arena.allocate( 100 ), 4, 100 );
+    }
+
+    TEST(Arena, ReallocateExtendsTheLastAllocation) {
+        Arena arena;
+        char* p = static_cast<char*>( arena.allocate( 10 ) );
+        std::strcpy( p, "arena" );
+        ASSERT_EQUALS( p, arena.reallocate( p, 10, 100 ) );
+        char* q = static_cast<char*>( arena.allocate( 10 ) );
+        char* r = static_cast<char*>( arena.reallocate( p, 100, 200 ) );
+        ASSERT( r != p );
+        ASSERT( r != q );
+        ASSERT_EQUALS( std::string( "arena" ), std::string( r ) );
+    }
+
+    TEST(Arena, CurrentOnlyWithinAnOperation) {
+        ASSERT( Arena::current() == NULL );
+        {
+            Arena::OpScope scope;
+            Arena* arena = Arena::current();
+            ASSERT( arena != NULL );
+            arena->allocate( 10 );
+            {
+                Arena::OpScope nested;
+                ASSERT( Arena::current() == arena );
+            }
+            // the nested scope didn't end the operation
+            ASSERT( Arena::current() == arena );
+            ASSERT_EQUALS( 1, arena->allocations() );
+        }
+        ASSERT( Arena::current() == NULL );
+    }
+
+    void fill( ArenaBufBuilder& b, int n ) {
+        for ( int i = 0; i < n; ++i )
+            b.appendNum( i );
+    }
+
+    void check( ArenaBufBuilder& b, int n ) {
+        ASSERT_EQUALS( n * 4, b.len() );
+        for ( int i = 0; i < n; ++i ) {
+            int x;
+            std::memcpy( &x, b.buf() + i * 4, 4 );
+            ASSERT_EQUALS( i, x );
+        }
+    }
+
+    TEST(ArenaBufBuilder, OutsideAnOperation) {
+        ArenaBufBuilder b;
+        fill( b, 10000 );
+        check( b, 10000 );
+    }
+
+    TEST(ArenaBufBuilder, WithinAnOperation) {
+        Arena::OpScope scope;
+        {
+            ArenaBufBuilder small;
+            fill( small, 10 );
+            check( small, 10 );
+        }
+        ASSERT_EQUALS( 0, Arena::current()->allocations() );
+        {
+            ArenaBufBuilder b;
+            fill( b, 10000 );
+            check( b, 10000 );
+        }
+        ASSERT( Arena::current()->allocations() > 0 );
+    }
+
+} // namespace
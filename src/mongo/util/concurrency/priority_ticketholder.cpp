@@ -0,0 +1,170 @@
+// @file priority_ticketholder.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/util/concurrency/priority_ticketholder.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+    PriorityTicketHolder::PriorityTicketHolder( int tickets , int numClasses )
+        : _mutex( "PriorityTicketHolder" ),
+          _outof( tickets ),
+          _used( 0 ),
+          _numClasses( numClasses ),
+          _numQueued( 0 ),
+          _maxQueueMicros( 0 ),
+          _pass( 0 ) {
+        verify( numClasses > 0 && numClasses <= MaxClasses );
+    }
+
+    long long PriorityTicketHolder::waitForTicket( int c ) {
+        verify( c >= 0 && c < _numClasses );
+        scoped_lock lk( _mutex );
+
+        if ( _used < _outof && _numQueued == 0 ) {
+            _used++;
+            _granted( c , 0 );
+            return 0;
+        }
+
+        Queue& q = _queues[c];
+        if ( q.waiters.empty() )
+            q.pass = std::max( q.pass , _pass );
+
+        Waiter w;
+        w.enqueued = curTimeMicros64();
+        q.waiters.push_back( &w );
+        _numQueued++;
+
+        _grant();
+        while ( ! w.granted )
+            w.c.wait( lk.boost() );
+
+        return curTimeMicros64() - w.enqueued;
+    }
+
+    void PriorityTicketHolder::release() {
+        scoped_lock lk( _mutex );
+        _used--;
+        _grant();
+    }
+
+    void PriorityTicketHolder::resize( int tickets ) {
+        scoped_lock lk( _mutex );
+        _outof = tickets;
+        _grant();
+    }
+
+    void PriorityTicketHolder::setWeight( int c , int weight ) {
+        verify( c >= 0 && c < _numClasses );
+        verify( weight > 0 );
+        scoped_lock lk( _mutex );
+        _queues[c].weight = weight;
+    }
+
+    void PriorityTicketHolder::setMaxQueueMillis( int millis ) {
+        scoped_lock lk( _mutex );
+        _maxQueueMicros = 1000LL * millis;
+    }
+
+    int PriorityTicketHolder::outof() const {
+        scoped_lock lk( _mutex );
+        return _outof;
+    }
+
+    int PriorityTicketHolder::used() const {
+        scoped_lock lk( _mutex );
+        return _used;
+    }
+
+    int PriorityTicketHolder::queued( int c ) const {
+        scoped_lock lk( _mutex );
+        return _queues[c].waiters.size();
+    }
+
+    void PriorityTicketHolder::_grant() {
+        if ( _used >= _outof || _numQueued == 0 )
+            return;
+
+        unsigned long long now = curTimeMicros64();
+        while ( _used < _outof && _numQueued > 0 ) {
+            int c = _pick( now );
+            Queue& q = _queues[c];
+            Waiter* w = q.waiters.front();
+            q.waiters.pop_front();
+            _numQueued--;
+
+            _pass = q.pass;
+            q.pass += Stride / q.weight;
+
+            _used++;
+            _granted( c , now > w->enqueued ? now - w->enqueued : 0 );
+            w->granted = true;
+            w->c.notify_one();
+        }
+    }
+
+    int PriorityTicketHolder::_pick( unsigned long long now ) const {
+        int oldest = -1;
+        int next = -1;
+        for ( int i = 0; i < _numClasses; i++ ) {
+            const Queue& q = _queues[i];
+            if ( q.waiters.empty() )
+                continue;
+
+            unsigned long long enqueued = q.waiters.front()->enqueued;
+            if ( _maxQueueMicros > 0 && now > enqueued &&
+                 static_cast<long long>( now - enqueued ) >= _maxQueueMicros ) {
+                if ( oldest < 0 || enqueued < _queues[oldest].waiters.front()->enqueued )
+                    oldest = i;
+            }
+
+            if ( next < 0 || q.pass < _queues[next].pass )
+                next = i;
+        }
+        return oldest >= 0 ? oldest : next;
+    }
+
+    void PriorityTicketHolder::_granted( int c , long long micros ) {
+        Queue& q = _queues[c];
+        q.granted++;
+        q.waitMicros += micros;
+        if ( micros > q.maxWaitMicros )
+            q.maxWaitMicros = micros;
+    }
+
+    void PriorityTicketHolder::append( BSONObjBuilder& b , const char* const* classNames ) const {
+        scoped_lock lk( _mutex );
+        b.append( "out" , _outof );
+        b.append( "used" , _used );
+        b.append( "maxQueueMillis" , static_cast<int>( _maxQueueMicros / 1000 ) );
+        for ( int i = 0; i < _numClasses; i++ ) {
+            const Queue& q = _queues[i];
+            BSONObjBuilder sub( b.subobjStart( classNames[i] ) );
+            sub.append( "weight" , q.weight );
+            sub.append( "queued" , static_cast<int>( q.waiters.size() ) );
+            sub.appendNumber( "granted" , q.granted );
+            sub.appendNumber( "waitMicros" , q.waitMicros );
+            sub.appendNumber( "maxWaitMicros" , q.maxWaitMicros );
+            sub.done();
+        }
+    }
+
+}
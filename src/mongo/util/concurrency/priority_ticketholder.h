@@ -0,0 +1,115 @@
+// @file priority_ticketholder.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "mongo/util/concurrency/mutex.h"
+
+namespace mongo {
+
+    class BSONObjBuilder;
+
+    /**
+     * A TicketHolder whose waiters are queued by class, for when there are more requests than
+     * tickets.
+     *
+     * While tickets are free they are handed out right away.  Once they run out, each ticket
+     * that is released goes to the head of one of the class queues:
+     *   - if any head has waited maxQueueMillis or more, the one that has waited longest;
+     *   - otherwise the queues share the tickets in proportion to their weights (stride
+     *     scheduling), so a busy class can't starve the others but still gets its share.
+     *
+     * A queue that was empty rejoins at the current pass rather than with the credit it
+     * would have built up while idle.
+     */
+    class PriorityTicketHolder : boost::noncopyable {
+    public:
+        enum { MaxClasses = 8 };
+
+        PriorityTicketHolder( int tickets , int numClasses );
+
+        /**
+         * Waits for a ticket for a request of class c.
+         * @return micros spent waiting
+         */
+        long long waitForTicket( int c );
+
+        void release();
+
+        /** Can shrink below what's in use; tickets released over the new limit aren't reissued. */
+        void resize( int tickets );
+
+        /** weight must be > 0 */
+        void setWeight( int c , int weight );
+        /** 0 turns off the latency bound, leaving only the weights */
+        void setMaxQueueMillis( int millis );
+
+        int outof() const;
+        int used() const;
+        int queued( int c ) const;
+
+        /**
+         * Appends { out : n , used : n , maxQueueMillis : n ,
+         *           <className> : { weight , queued , granted , waitMicros , maxWaitMicros } ... }
+         */
+        void append( BSONObjBuilder& b , const char* const* classNames ) const;
+
+    private:
+        struct Waiter {
+            Waiter() : granted( false ), enqueued( 0 ) { }
+            boost::condition_variable_any c;
+            bool granted;
+            unsigned long long enqueued;
+        };
+
+        struct Queue {
+            Queue() : weight( 1 ), pass( 0 ), granted( 0 ), waitMicros( 0 ), maxWaitMicros( 0 ) { }
+            std::deque<Waiter*> waiters;
+            int weight;
+            unsigned long long pass;
+            long long granted;
+            long long waitMicros;
+            long long maxWaitMicros;
+        };
+
+        enum { Stride = 1 << 20 };
+
+        /** hands out free tickets to waiters.  you must hold _mutex */
+        void _grant();
+
+        /** @return the queue the next ticket goes to, or -1 if nothing is waiting */
+        int _pick( unsigned long long now ) const;
+
+        void _granted( int c , long long micros );
+
+        mutable mongo::mutex _mutex;
+        int _outof;
+        int _used;
+        int _numClasses;
+        int _numQueued;
+        long long _maxQueueMicros;
+        unsigned long long _pass; // of the last queue picked
+        Queue _queues[MaxClasses];
+    };
+
+}
@@ -0,0 +1,144 @@
+// priority_ticketholder_test.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/priority_ticketholder.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+    TEST(PriorityTicketHolder, FreeTicketsDontWait) {
+        PriorityTicketHolder h(2, 2);
+        ASSERT_EQUALS(0, h.waitForTicket(0));
+        ASSERT_EQUALS(0, h.waitForTicket(1));
+        ASSERT_EQUALS(2, h.used());
+        h.release();
+        h.release();
+        ASSERT_EQUALS(0, h.used());
+    }
+
+    /** takes a ticket, notes which class got it, and gives it back */
+    struct Grants {
+        Grants() : m("Grants") {}
+        mongo::mutex m;
+        vector<int> order;
+
+        void take(PriorityTicketHolder* h, int c) {
+            h->waitForTicket(c);
+            {
+                scoped_lock lk(m);
+                order.push_back(c);
+            }
+            h->release();
+        }
+    };
+
+    void waitForQueued(const PriorityTicketHolder& h, int c, int n) {
+        while (h.queued(c) < n)
+            sleepmillis(1);
+    }
+
+    TEST(PriorityTicketHolder, SharesTicketsByWeight) {
+        PriorityTicketHolder h(1, 2);
+        h.setWeight(0, 3);
+        h.setWeight(1, 1);
+        h.waitForTicket(0);
+
+        Grants grants;
+        boost::thread_group threads;
+        for (int i = 0; i < 8; i++) {
+            threads.create_thread(boost::bind(&Grants::take, &grants, &h, 0));
+            threads.create_thread(boost::bind(&Grants::take, &grants, &h, 1));
+        }
+        waitForQueued(h, 0, 8);
+        waitForQueued(h, 1, 8);
+
+        h.release();
+        threads.join_all();
+
+        ASSERT_EQUALS(16U, grants.order.size());
+        int first = 0;
+        for (int i = 0; i < 8; i++)
+            first += grants.order[i] == 0;
+        ASSERT_EQUALS(6, first);
+        ASSERT_EQUALS(0, h.used());
+    }
+
+    TEST(PriorityTicketHolder, MaxQueueMillisBoundsWaits) {
+        PriorityTicketHolder h(1, 2);
+        h.setWeight(0, 1000);
+        h.setMaxQueueMillis(1);
+        h.waitForTicket(0);
+
+        Grants grants;
+        boost::thread_group threads;
+        threads.create_thread(boost::bind(&Grants::take, &grants, &h, 1));
+        waitForQueued(h, 1, 1);
+        sleepmillis(10);
+        for (int i = 0; i < 4; i++)
+            threads.create_thread(boost::bind(&Grants::take, &grants, &h, 0));
+        waitForQueued(h, 0, 4);
+
+        h.release();
+        threads.join_all();
+
+        ASSERT_EQUALS(5U, grants.order.size());
+        ASSERT_EQUALS(1, grants.order[0]);
+    }
+
+    TEST(PriorityTicketHolder, Resize) {
+        PriorityTicketHolder h(1, 1);
+        h.waitForTicket(0);
+
+        Grants grants;
+        boost::thread waiter(boost::bind(&Grants::take, &grants, &h, 0));
+        waitForQueued(h, 0, 1);
+        h.resize(2);
+        waiter.join();
+        ASSERT_EQUALS(1U, grants.order.size());
+
+        h.resize(0);
+        h.release();
+        ASSERT_EQUALS(0, h.used());
+        ASSERT_EQUALS(0, h.outof());
+    }
+
+    TEST(PriorityTicketHolder, Append) {
+        PriorityTicketHolder h(4, 2);
+        h.setWeight(1, 5);
+        h.waitForTicket(1);
+
+        const char* names[] = { "a", "b" };
+        BSONObjBuilder b;
+        h.append(b, names);
+        BSONObj o = b.obj();
+        ASSERT_EQUALS(4, o["out"].numberInt());
+        ASSERT_EQUALS(1, o["used"].numberInt());
+        ASSERT_EQUALS(0, o["a"]["granted"].numberLong());
+        ASSERT_EQUALS(5, o["b"]["weight"].numberInt());
+        ASSERT_EQUALS(1, o["b"]["granted"].numberLong());
+        ASSERT_EQUALS(0, o["b"]["queued"].numberInt());
+    }
+
+} // namespace
+} // namespace mongo
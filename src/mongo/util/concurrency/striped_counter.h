@@ -0,0 +1,78 @@
+// striped_counter.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/compiler.h"
+
+namespace mongo {
+
+    enum { StripeCount = 16 };
+
+    /**
+     * @return the stripe of the calling thread, in [0, StripeCount).  Threads are assigned
+     * stripes round robin the first time they ask.
+     */
+    unsigned threadStripe();
+
+    /**
+     * A set of NCounters counters bumped by every operation and read rarely, such as the
+     * opcounters.  Each stripe has its own cache line(s) and a thread only adds to its own
+     * stripe, so threads on different cores don't contend on the counters.  Threads sharing a
+     * stripe still add atomically.  Reads add up the stripes.
+     *
+     *   StripedCounters<2> c;
+     *   c.add( 0 , 1 );
+     *   long long n = c.get( 0 );
+     *
+     * Reads race with concurrent adds, as they did with a single shared counter.
+     */
+    template< int NCounters >
+    class StripedCounters {
+        MONGO_DISALLOW_COPYING(StripedCounters);
+    public:
+        StripedCounters() {}
+
+        /** @return the new value of the caller's stripe of the counter */
+        long long add( int counter , long long n ) {
+            return _stripes[ threadStripe() ].counters[ counter ].addAndFetch( n );
+        }
+
+        long long get( int counter ) const {
+            long long total = 0;
+            for ( int i = 0; i < StripeCount; i++ )
+                total += _stripes[i].counters[ counter ].load();
+            return total;
+        }
+
+        void reset() {
+            for ( int i = 0; i < StripeCount; i++ )
+                for ( int j = 0; j < NCounters; j++ )
+                    _stripes[i].counters[j].store( 0 );
+        }
+
+    private:
+        struct MONGO_COMPILER_ALIGN_TYPE( 64 ) Stripe {
+            AtomicInt64 counters[ NCounters ];
+        };
+        Stripe _stripes[ StripeCount ];
+    };
+
+}
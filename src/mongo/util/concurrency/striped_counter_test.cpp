@@ -0,0 +1,81 @@
+// striped_counter_test.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/striped_counter.h"
+
+namespace mongo {
+namespace {
+
+    typedef StripedCounters<3> Counters;
+
+    TEST(StripedCounters, StartsAtZero) {
+        Counters c;
+        ASSERT_EQUALS(0, c.get(0));
+        ASSERT_EQUALS(0, c.get(2));
+    }
+
+    TEST(StripedCounters, AddAndGet) {
+        Counters c;
+        ASSERT_EQUALS(5, c.add(1, 5));
+        ASSERT_EQUALS(7, c.add(1, 2));
+        c.add(2, -3);
+        ASSERT_EQUALS(0, c.get(0));
+        ASSERT_EQUALS(7, c.get(1));
+        ASSERT_EQUALS(-3, c.get(2));
+        c.reset();
+        ASSERT_EQUALS(0, c.get(1));
+        ASSERT_EQUALS(0, c.get(2));
+    }
+
+    TEST(StripedCounters, StripesAreCacheLines) {
+        ASSERT_EQUALS(0U, sizeof(Counters) % 64);
+        ASSERT_EQUALS(0U, sizeof(StripedCounters<8>) % 64);
+        ASSERT_EQUALS(StripeCount * 128U, sizeof(StripedCounters<9>));
+    }
+
+    TEST(StripedCounters, ThreadStripeIsStable) {
+        unsigned stripe = threadStripe();
+        ASSERT_LESS_THAN(stripe, static_cast<unsigned>(StripeCount));
+        ASSERT_EQUALS(stripe, threadStripe());
+    }
+
+    void addMany(Counters* c) {
+        for (int i = 0; i < 10000; i++) {
+            c->add(0, 1);
+            c->add(1, 2);
+        }
+    }
+
+    TEST(StripedCounters, ManyThreads) {
+        Counters c;
+        boost::thread_group threads;
+        const int nThreads = StripeCount + 4; // some threads share a stripe
+        for (int i = 0; i < nThreads; i++)
+            threads.create_thread(boost::bind(addMany, &c));
+        threads.join_all();
+        ASSERT_EQUALS(nThreads * 10000LL, c.get(0));
+        ASSERT_EQUALS(nThreads * 20000LL, c.get(1));
+        ASSERT_EQUALS(0, c.get(2));
+    }
+
+} // namespace
+} // namespace mongo
@@ -0,0 +1,197 @@
+// @file task_executor.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/util/concurrency/task_executor.h"
+
+#include <boost/thread/thread.hpp>
+
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/threadlocal.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+    /** which executor's worker the current thread is, if any */
+    struct TaskExecutorWorker {
+        TaskExecutorWorker() : executor( 0 ), index( -1 ) { }
+        const TaskExecutor* executor;
+        int index;
+    };
+
+    TSP_DECLARE(TaskExecutorWorker, taskExecutorWorker)
+    TSP_DEFINE(TaskExecutorWorker, taskExecutorWorker)
+
+    TaskExecutor::TaskExecutor( int nThreads , const std::string& name )
+        : _name( name ), _mutex( "TaskExecutor" ), _shutdown( false ) {
+        verify( nThreads > 0 );
+        for ( int i = 0; i < nThreads; i++ )
+            _workers.push_back( new Worker() );
+        // only now, as workers look at each other's deques
+        for ( int i = 0; i < nThreads; i++ )
+            _workers[i]->thread = new boost::thread( boost::bind( &TaskExecutor::_loop , this , i ) );
+    }
+
+    TaskExecutor::~TaskExecutor() {
+        {
+            scoped_lock lk( _mutex );
+            _shutdown = true;
+        }
+        _wake.notify_all();
+
+        for ( unsigned i = 0; i < _workers.size(); i++ )
+            _workers[i]->thread->join();
+        // only now, as a worker can be stealing from another until it stops
+        for ( unsigned i = 0; i < _workers.size(); i++ ) {
+            delete _workers[i]->thread;
+            delete _workers[i];
+        }
+    }
+
+    void TaskExecutor::schedule( const Task& task , Priority p ) {
+        verify( ! task.empty() );
+
+        TaskExecutorWorker* self = taskExecutorWorker.get();
+        int target = self && self->executor == this ?
+            self->index : _next.fetchAndAdd( 1 ) % _workers.size();
+
+        Worker& w = *_workers[target];
+        {
+            SimpleMutex::scoped_lock lk( w.lock );
+            w.tasks[p].push_back( task );
+        }
+
+        // a worker going idle counts itself before looking at _pending, so either it sees this
+        // task or we see it and wait for it to be asleep before waking it
+        _pending.fetchAndAdd( 1 );
+        if ( _idle.load() > 0 ) {
+            { scoped_lock lk( _mutex ); }
+            _wake.notify_one();
+        }
+    }
+
+    bool TaskExecutor::_takeOwn( int me , Task& task ) {
+        Worker& w = *_workers[me];
+        SimpleMutex::scoped_lock lk( w.lock );
+        for ( int p = 0; p < NumPriorities; p++ ) {
+            if ( ! w.tasks[p].empty() ) {
+                task.swap( w.tasks[p].front() );
+                w.tasks[p].pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TaskExecutor::_steal( int me , Task& task ) {
+        int n = _workers.size();
+        for ( int p = 0; p < NumPriorities; p++ ) {
+            for ( int i = 1; i < n; i++ ) {
+                Worker& w = *_workers[ ( me + i ) % n ];
+                SimpleMutex::scoped_lock lk( w.lock );
+                if ( ! w.tasks[p].empty() ) {
+                    task.swap( w.tasks[p].back() );
+                    w.tasks[p].pop_back();
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void TaskExecutor::_loop( int me ) {
+        TaskExecutorWorker* self = new TaskExecutorWorker();
+        self->executor = this;
+        self->index = me;
+        taskExecutorWorker.reset( self );
+
+        while ( true ) {
+            Task task;
+            if ( _takeOwn( me , task ) ) {
+                _pending.fetchAndSubtract( 1 );
+            }
+            else if ( _steal( me , task ) ) {
+                _pending.fetchAndSubtract( 1 );
+                _stolen.fetchAndAdd( 1 );
+            }
+            else {
+                scoped_lock lk( _mutex );
+                _idle.fetchAndAdd( 1 );
+                while ( _pending.load() <= 0 && ! _shutdown )
+                    _wake.wait( lk.boost() );
+                _idle.fetchAndSubtract( 1 );
+                if ( _pending.load() <= 0 && _shutdown )
+                    break;
+                continue;
+            }
+
+            try {
+                task();
+            }
+            catch ( DBException& e ) {
+                log() << _name << ": unhandled DBException: " << e.toString() << std::endl;
+            }
+            catch ( std::exception& e ) {
+                log() << _name << ": unhandled std::exception in task: " << e.what() << std::endl;
+            }
+            catch ( ... ) {
+                log() << _name << ": unhandled non-exception in task" << std::endl;
+            }
+        }
+
+        taskExecutorWorker.reset( 0 );
+    }
+
+    TaskExecutor::Group::Group( TaskExecutor& executor , Priority p )
+        : _executor( executor ), _priority( p ), _mutex( "TaskExecutor::Group" ) {
+    }
+
+    TaskExecutor::Group::~Group() {
+        join();
+    }
+
+    void TaskExecutor::Group::schedule( const Task& task ) {
+        _remaining.fetchAndAdd( 1 );
+        _executor.schedule( boost::bind( &Group::_run , this , task ) , _priority );
+    }
+
+    void TaskExecutor::Group::join() {
+        scoped_lock lk( _mutex );
+        while ( _remaining.load() > 0 )
+            _done.wait( lk.boost() );
+    }
+
+    void TaskExecutor::Group::_finished() {
+        // only the last one in needs the mutex, to not slip in between join's check and wait
+        if ( _remaining.subtractAndFetch( 1 ) == 0 ) {
+            scoped_lock lk( _mutex );
+            _done.notify_all();
+        }
+    }
+
+    void TaskExecutor::Group::_run( const Task& task ) {
+        try {
+            task();
+        }
+        catch ( ... ) {
+            _finished();
+            throw;
+        }
+        _finished();
+    }
+
+}
@@ -0,0 +1,129 @@
+// @file task_executor.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition.hpp>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/mutex.h"
+
+namespace boost {
+    class thread;
+}
+
+namespace mongo {
+
+    /**
+     * A fixed set of worker threads that several users can share, unlike ThreadPool, which
+     * has one queue under one mutex.
+     *
+     * Each worker has its own deque per priority.  A task scheduled from a worker goes on that
+     * worker's deque and one scheduled from any other thread goes to the workers round robin.
+     * A worker runs its own tasks highest priority first and oldest first, and when it has
+     * none steals the newest task of the highest priority another worker has, leaving the
+     * owner's next tasks where they are.  So priorities are per worker: a Normal task can run
+     * while another worker still holds a High one, at most until someone is idle enough to
+     * steal it.
+     *
+     * Tasks run on whichever worker gets to them, so anything a task needs from its thread
+     * (a Client, lock settings) it has to set up itself.
+     */
+    class TaskExecutor : boost::noncopyable {
+    public:
+        typedef boost::function<void(void)> Task;
+
+        enum Priority { High = 0, Normal, Low, NumPriorities };
+
+        TaskExecutor( int nThreads , const std::string& name );
+
+        /** runs what's left, then stops the workers */
+        ~TaskExecutor();
+
+        void schedule( const Task& task , Priority p = Normal );
+
+        int threads() const { return _workers.size(); }
+
+        /** tasks run by a worker other than the one they were scheduled on */
+        long long stolen() const { return _stolen.load(); }
+
+        /** Tasks scheduled through a Group can be waited for together. */
+        class Group : boost::noncopyable {
+        public:
+            Group( TaskExecutor& executor , Priority p = Normal );
+
+            /** joins */
+            ~Group();
+
+            void schedule( const Task& task );
+
+            // Helpers that wrap schedule and boost::bind, as in ThreadPool
+            template<typename F, typename A>
+            void schedule(F f, A a) { schedule(boost::bind(f,a)); }
+            template<typename F, typename A, typename B>
+            void schedule(F f, A a, B b) { schedule(boost::bind(f,a,b)); }
+            template<typename F, typename A, typename B, typename C>
+            void schedule(F f, A a, B b, C c) { schedule(boost::bind(f,a,b,c)); }
+
+            /** blocks until every task scheduled so far is done */
+            void join();
+
+        private:
+            void _run( const Task& task );
+            void _finished();
+
+            TaskExecutor& _executor;
+            const Priority _priority;
+            mongo::mutex _mutex;
+            boost::condition _done;
+            AtomicInt32 _remaining;
+        };
+
+    private:
+        struct Worker {
+            Worker() : lock( "TaskExecutor::Worker" ), thread( 0 ) { }
+            SimpleMutex lock;
+            std::deque<Task> tasks[NumPriorities];
+            boost::thread* thread;
+        };
+
+        void _loop( int me );
+        bool _takeOwn( int me , Task& task );
+        bool _steal( int me , Task& task );
+
+        const std::string _name;
+        std::vector<Worker*> _workers;
+        AtomicUInt32 _next;   // worker for the next task scheduled from outside
+        AtomicInt32 _pending; // tasks on the deques, can be briefly off by the tasks in flight
+        AtomicInt64 _stolen;
+        AtomicInt32 _idle;    // workers waiting on _wake, or about to
+
+        // idle workers wait here
+        mongo::mutex _mutex;
+        boost::condition _wake;
+        bool _shutdown;
+    };
+
+}
@@ -0,0 +1,125 @@
+// task_executor_test.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/task_executor.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+    void increment(AtomicInt32* n) {
+        n->fetchAndAdd(1);
+    }
+
+    TEST(TaskExecutor, GroupRunsEverything) {
+        TaskExecutor executor(4, "test");
+        AtomicInt32 n;
+        TaskExecutor::Group group(executor);
+        for (int i = 0; i < 1000; i++)
+            group.schedule(increment, &n);
+        group.join();
+        ASSERT_EQUALS(1000, n.load());
+    }
+
+    TEST(TaskExecutor, DestructorFinishesTasks) {
+        AtomicInt32 n;
+        {
+            TaskExecutor executor(2, "test");
+            for (int i = 0; i < 100; i++)
+                executor.schedule(boost::bind(increment, &n));
+        }
+        ASSERT_EQUALS(100, n.load());
+    }
+
+    void slowIncrement(AtomicInt32* n) {
+        sleepmillis(1);
+        n->fetchAndAdd(1);
+    }
+
+    /** schedules from a worker, so everything lands on that worker's deque */
+    void fanOut(TaskExecutor::Group* group, AtomicInt32* n) {
+        for (int i = 0; i < 40; i++)
+            group->schedule(slowIncrement, n);
+    }
+
+    TEST(TaskExecutor, IdleWorkersSteal) {
+        TaskExecutor executor(4, "test");
+        AtomicInt32 n;
+        TaskExecutor::Group group(executor);
+        group.schedule(fanOut, &group, &n);
+        sleepmillis(5);
+        group.join();
+        ASSERT_EQUALS(40, n.load());
+        ASSERT_LESS_THAN(0, executor.stolen());
+    }
+
+    void waitFor(const AtomicInt32* flag) {
+        while (!flag->load())
+            sleepmillis(1);
+    }
+
+    struct Order {
+        Order() : m("Order") {}
+        SimpleMutex m;
+        std::vector<int> v;
+        void add(int i) {
+            SimpleMutex::scoped_lock lk(m);
+            v.push_back(i);
+        }
+    };
+
+    TEST(TaskExecutor, HigherPrioritiesFirst) {
+        TaskExecutor executor(1, "test");
+        AtomicInt32 go;
+        Order order;
+        TaskExecutor::Group blocker(executor);
+        blocker.schedule(waitFor, &go);
+
+        executor.schedule(boost::bind(&Order::add, &order, 2), TaskExecutor::Low);
+        executor.schedule(boost::bind(&Order::add, &order, 1), TaskExecutor::Normal);
+        executor.schedule(boost::bind(&Order::add, &order, 0), TaskExecutor::High);
+
+        TaskExecutor::Group last(executor, TaskExecutor::Low);
+        last.schedule(boost::bind(&Order::add, &order, 3));
+
+        go.store(1);
+        blocker.join();
+        last.join();
+
+        ASSERT_EQUALS(4U, order.v.size());
+        for (int i = 0; i < 4; i++)
+            ASSERT_EQUALS(i, order.v[i]);
+    }
+
+    void throwSomething() {
+        throw std::exception();
+    }
+
+    TEST(TaskExecutor, ExceptionsDontStopWorkers) {
+        TaskExecutor executor(1, "test");
+        AtomicInt32 n;
+        TaskExecutor::Group group(executor);
+        group.schedule(boost::bind(throwSomething));
+        group.schedule(increment, &n);
+        group.join();
+        ASSERT_EQUALS(1, n.load());
+    }
+
+} // namespace
+} // namespace mongo
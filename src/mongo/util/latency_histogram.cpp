@@ -0,0 +1,107 @@
+// latency_histogram.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/util/latency_histogram.h"
+
+#include <cmath>
+
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+    int LatencyHistogram::bucketFor( long long micros ) {
+        if ( micros < SubBuckets )
+            return micros < 0 ? 0 : static_cast<int>( micros );
+        if ( micros >> MaxExponent )
+            return NumBuckets - 1;
+
+        int exponent = SubBucketBits;
+        while ( micros >> ( exponent + 1 ) )
+            exponent++;
+
+        int subBucket = static_cast<int>( micros >> ( exponent - SubBucketBits ) ) - SubBuckets;
+        return ( exponent - SubBucketBits + 1 ) * SubBuckets + subBucket;
+    }
+
+    long long LatencyHistogram::bucketUpperBound( int bucket ) {
+        if ( bucket < SubBuckets )
+            return bucket;
+        int shift = bucket / SubBuckets - 1;
+        long long subBucket = bucket % SubBuckets;
+        return ( ( SubBuckets + subBucket + 1 ) << shift ) - 1;
+    }
+
+    long long LatencyHistogram::count() const {
+        long long total = 0;
+        for ( int i = 0; i < NumBuckets; i++ )
+            total += _buckets[i].load();
+        return total;
+    }
+
+    long long LatencyHistogram::percentile( double p ) const {
+        long long counts[ NumBuckets ];
+        long long total = 0;
+        for ( int i = 0; i < NumBuckets; i++ )
+            total += counts[i] = _buckets[i].load();
+        return _percentile( counts , total , p );
+    }
+
+    long long LatencyHistogram::_percentile( const long long* counts , long long total , double p ) {
+        if ( total == 0 )
+            return 0;
+
+        long long rank = std::max( 1LL , static_cast<long long>( std::ceil( p * total ) ) );
+        long long seen = 0;
+        for ( int i = 0; i < NumBuckets; i++ ) {
+            seen += counts[i];
+            if ( seen >= rank )
+                return bucketUpperBound( i );
+        }
+        return bucketUpperBound( NumBuckets - 1 );
+    }
+
+    void LatencyHistogram::reset() {
+        for ( int i = 0; i < NumBuckets; i++ )
+            _buckets[i].store( 0 );
+    }
+
+    void LatencyHistogram::append( BSONObjBuilder& b ) const {
+        // work from one copy so the percentiles and buckets agree
+        long long counts[ NumBuckets ];
+        long long total = 0;
+        for ( int i = 0; i < NumBuckets; i++ )
+            total += counts[i] = _buckets[i].load();
+
+        b.appendNumber( "count" , total );
+        b.appendNumber( "p50" , _percentile( counts , total , 0.5 ) );
+        b.appendNumber( "p99" , _percentile( counts , total , 0.99 ) );
+        b.appendNumber( "p999" , _percentile( counts , total , 0.999 ) );
+
+        BSONArrayBuilder buckets( b.subarrayStart( "buckets" ) );
+        for ( int i = 0; i < NumBuckets; i++ ) {
+            if ( counts[i] == 0 )
+                continue;
+            BSONArrayBuilder bucket( buckets.subarrayStart() );
+            bucket.append( bucketUpperBound( i ) );
+            bucket.append( counts[i] );
+            bucket.done();
+        }
+        buckets.done();
+    }
+
+}
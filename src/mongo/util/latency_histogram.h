@@ -0,0 +1,77 @@
+// latency_histogram.h
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+    class BSONObjBuilder;
+
+    /**
+     * A histogram of latencies in microseconds, cheap enough to record every operation into.
+     *
+     * Buckets are log-linear, as in HdrHistogram: values below 16 get a bucket each, and every
+     * power of two range above that is split into 16 equal buckets, so a bucket's bounds are
+     * within 1/16 of each other.  Values of 2^36 micros (19 hours) and more share the last
+     * bucket.  Percentiles are reported as the upper bound of the bucket they fall in.
+     *
+     * Recording is one atomic add.  Reads don't stop concurrent records, so they may see some
+     * buckets of a record that's in progress elsewhere and not others.
+     */
+    class LatencyHistogram {
+        MONGO_DISALLOW_COPYING(LatencyHistogram);
+    public:
+        enum { SubBucketBits = 4,
+               SubBuckets = 1 << SubBucketBits,
+               MaxExponent = 36,
+               NumBuckets = SubBuckets * ( MaxExponent - SubBucketBits + 1 ) };
+
+        LatencyHistogram() {}
+
+        void record( long long micros ) { _buckets[ bucketFor( micros ) ].fetchAndAdd( 1 ); }
+
+        long long count() const;
+
+        /** @return the latency that a fraction p of the recorded values are at or below */
+        long long percentile( double p ) const;
+
+        void reset();
+
+        /**
+         * Appends { count : n , p50 : micros , p99 : micros , p999 : micros ,
+         *           buckets : [ [ upperBound , count ] ... ] }
+         * where buckets holds the nonempty buckets, so that clients can work out the
+         * percentiles of the values recorded between two samples.
+         */
+        void append( BSONObjBuilder& b ) const;
+
+        static int bucketFor( long long micros );
+
+        /** @return the largest value that falls in the bucket */
+        static long long bucketUpperBound( int bucket );
+
+    private:
+        static long long _percentile( const long long* counts , long long total , double p );
+
+        AtomicInt64 _buckets[ NumBuckets ];
+    };
+
+}
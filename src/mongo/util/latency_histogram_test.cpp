@@ -0,0 +1,103 @@
+// latency_histogram_test.cpp
+
+/**
+*    Copyright (C) 2012 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/latency_histogram.h"
+
+namespace mongo {
+namespace {
+
+    TEST(LatencyHistogram, SmallValuesAreExact) {
+        for (int i = 0; i < LatencyHistogram::SubBuckets; i++) {
+            ASSERT_EQUALS(i, LatencyHistogram::bucketFor(i));
+            ASSERT_EQUALS(i, LatencyHistogram::bucketUpperBound(i));
+        }
+        ASSERT_EQUALS(0, LatencyHistogram::bucketFor(-5));
+    }
+
+    TEST(LatencyHistogram, BucketsAreLogLinear) {
+        // 16..31 are still exact, then buckets double in width with each power of two
+        ASSERT_EQUALS(16, LatencyHistogram::bucketFor(16));
+        ASSERT_EQUALS(31, LatencyHistogram::bucketFor(31));
+        ASSERT_EQUALS(32, LatencyHistogram::bucketFor(32));
+        ASSERT_EQUALS(32, LatencyHistogram::bucketFor(33));
+        ASSERT_EQUALS(33LL, LatencyHistogram::bucketUpperBound(32));
+        ASSERT_EQUALS(1023LL, LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketFor(1000)));
+
+        for (long long v = 1; v < (1LL << LatencyHistogram::MaxExponent); v = v * 3 + 1) {
+            int bucket = LatencyHistogram::bucketFor(v);
+            long long upper = LatencyHistogram::bucketUpperBound(bucket);
+            ASSERT_LESS_THAN_OR_EQUALS(v, upper);
+            ASSERT_LESS_THAN_OR_EQUALS(upper - v, v / LatencyHistogram::SubBuckets);
+            if (bucket > 0) {
+                ASSERT_LESS_THAN(LatencyHistogram::bucketUpperBound(bucket - 1), v);
+            }
+        }
+    }
+
+    TEST(LatencyHistogram, LargeValuesShareTheLastBucket) {
+        ASSERT_EQUALS(LatencyHistogram::NumBuckets - 1,
+                      LatencyHistogram::bucketFor((1LL << LatencyHistogram::MaxExponent) - 1));
+        ASSERT_EQUALS(LatencyHistogram::NumBuckets - 1,
+                      LatencyHistogram::bucketFor(1LL << 50));
+    }
+
+    TEST(LatencyHistogram, Percentiles) {
+        LatencyHistogram h;
+        ASSERT_EQUALS(0, h.count());
+        ASSERT_EQUALS(0, h.percentile(0.5));
+
+        for (int i = 1; i <= 1000; i++)
+            h.record(i % 10 == 0 ? 5000 : 7);
+        h.record(100000);
+
+        ASSERT_EQUALS(1001, h.count());
+        ASSERT_EQUALS(7, h.percentile(0.5));
+        long long p99 = h.percentile(0.99);
+        ASSERT_LESS_THAN_OR_EQUALS(5000, p99);
+        ASSERT_LESS_THAN(p99, 5000 + 5000 / 16);
+        ASSERT_LESS_THAN_OR_EQUALS(100000, h.percentile(1));
+
+        h.reset();
+        ASSERT_EQUALS(0, h.count());
+    }
+
+    TEST(LatencyHistogram, Append) {
+        LatencyHistogram h;
+        h.record(3);
+        h.record(3);
+        h.record(40);
+
+        BSONObjBuilder b;
+        h.append(b);
+        BSONObj o = b.obj();
+        ASSERT_EQUALS(3, o["count"].numberLong());
+        ASSERT_EQUALS(3, o["p50"].numberLong());
+        ASSERT_EQUALS(41, o["p999"].numberLong());
+
+        vector<BSONElement> buckets = o["buckets"].Array();
+        ASSERT_EQUALS(2U, buckets.size());
+        ASSERT_EQUALS(3, buckets[0].Array()[0].numberLong());
+        ASSERT_EQUALS(2, buckets[0].Array()[1].numberLong());
+        ASSERT_EQUALS(41, buckets[1].Array()[0].numberLong());
+        ASSERT_EQUALS(1, buckets[1].Array()[1].numberLong());
+    }
+
+} // namespace
+} // namespace mongo